@@ -35,15 +35,32 @@ The general workflow for generating a new bitmap file is as follows _(these inst
 
 ### Usage
 
-`python3 bitmap_gen.py` _source-file_ _output-file_ _width_ _height_
+`python3 bitmap_gen.py` [--v2] _source-file_ _output-file_ _width_ _height_
 
 |PARAMETER|DESCRIPTION|
 |:-----|:-----|
+|--v2|(optional) generate a version 2 bitmap _(see below)_|
 |source file|4 indexed monochrome bitmap file in RAW format|
 |output file| header file output|
 |width|pixel width of source bitmap|
 |height|pixel height of source bitmap|
 
+### Version 2 Bitmaps
+
+A version 1 bitmap is a single run-length-encoded stream which can only be drawn in full, from the start.
+A version 2 bitmap adds a table with the offset of each row and encodes each row on its own with a mix of runs and literals.
+`lcdBitmapClip()` uses the table to start at any row, so part of an image may be drawn _(eg: panning a large image or
+slicing a sprite sheet)_ without decoding the rows which are not displayed. Version 2 is usually smaller for detailed images.
+
+Both versions are drawn with `lcdBitmap()` and `lcdBitmapClip()`.
+
+|BYTES|DESCRIPTION|
+|:-----|:-----|
+|2|width in pixels with the high bit (`0x8000`) set to identify version 2|
+|2|height in pixels|
+|2 per row|offset of the row's packets from the end of the table|
+|packets|`0x80 + (n - 1)` followed by one triplet for a run of n; `(n - 1)` followed by n triplets for n literals; n is 1 to 128|
+
 ### Example
 
 `python3 bitmap_gen.py` menu_ball18.raw ball18.h 18 18`
@@ -76,6 +93,7 @@ parser.add_argument('filein', help='bitmap file in raw format to convert')
 parser.add_argument('fileout', help='.h file')
 parser.add_argument('width',type=int, nargs=1, help='width of bitmap')
 parser.add_argument('height',type=int, nargs=1, help='height of bitmap')
+parser.add_argument('--v2', action='store_true', help='generate a version 2 bitmap with a row table and run/literal packets')
 parser.add_argument('--version', action='version', version='%(prog)s 1.0')
 
 #parse the command line
@@ -85,6 +103,7 @@ width = dict['width'][0]
 height = dict['height'][0]
 infilename = dict['filein']
 outfilename = dict['fileout']
+v2 = dict['v2']
 
 padding = 0
 if (width % 3 > 0):
@@ -100,7 +119,10 @@ fileout.write('// GENERATED FILE - DO NOT EDIT\n')
 fileout.write('// To change bitmaps, edit and run python3 bitmap_gen.py\n')
 fileout.write('// generated from RAW bitmap file: "%s"\n' % (infilename))
 fileout.write('\n')
-fileout.write('// NOTE: Data is run length encoded width (bits) first by height (bits).\n')
+if (v2):
+	fileout.write('// NOTE: Data is a version 2 bitmap; a table of row offsets is followed by run and literal packets for each row.\n')
+else:
+	fileout.write('// NOTE: Data is run length encoded width (bits) first by height (bits).\n')
 fileout.write('//       each byte represents up to 3 pixels - called a TRIPLET - to match the LCD driver of the SRXE.\n')
 fileout.write('\n')
 if (padding):
@@ -127,8 +149,9 @@ fileout.write('\n')
 fileout.write('const uint8_t {0}[] PROGMEM ='.format(name[0]))
 fileout.write('{\n\t')
 
-#put size of the picture as a header of the bitmap
-fileout.write('0x{0:02x}, 0x{1:02x}, // image width={2}\n\t'.format((width+padding) & 0xff, (width+padding)>>8 & 0xFF, (width+padding)))
+#put size of the picture as a header of the bitmap; version 2 is identified by the high bit of the width
+flag = 0x80 if v2 else 0x00
+fileout.write('0x{0:02x}, 0x{1:02x}, // image width={2}\n\t'.format((width+padding) & 0xff, ((width+padding)>>8 & 0xFF) | flag, (width+padding)))
 fileout.write('0x{0:02x}, 0x{1:02x}, // image height={2}\n\t'.format(height & 0xff, height>>8 & 0xFF, height))
 
 with open( infilename, 'rb' ) as filein:
@@ -139,12 +162,9 @@ count = 0	# count of byte processed
 countr = 0	# count of byte read
 countw = 0	# count byte written
 
-first = 1 # Flag telling that we have just started
-countRLE = 0 # count number of same bytes
-prev_char = 4 # hold value of current running length (4 is an impossible value in the context)
-
-# bytearray used to hold 3 pixels at a time
-ba = bytearray()
+# convert the pixels to triplets
+triplets = []
+ba = bytearray() # bytearray used to hold 3 pixels at a time
 for byte in data:
 	if byte > 4: # skip 0xFF high order bytes
 		continue
@@ -160,6 +180,58 @@ for byte in data:
 
 	if(count%3==0):  # every 3 pixels concatenate them into one byte
 		pix = color[ba.pop()] & mask[0] | color[ba.pop()] & mask[1] | color[ba.pop()] & mask[2]
+		triplets.append(pix)
+
+
+def encode_row(row):
+	# a row is encoded as packets; runs of 3 or more are worth a run packet, everything else is collected as literals
+	packets = []
+	literals = []
+	i = 0
+	while i < len(row):
+		n = 1
+		while (i + n < len(row)) and (row[i + n] == row[i]) and (n < 128):
+			n += 1
+		if n >= 3:
+			while literals:
+				packets += [len(literals[:128]) - 1] + literals[:128]
+				literals = literals[128:]
+			packets += [0x80 + (n - 1), row[i]]
+		else:
+			literals += row[i:i + n]
+		i += n
+	while literals:
+		packets += [len(literals[:128]) - 1] + literals[:128]
+		literals = literals[128:]
+	return packets
+
+
+if (v2):
+	row_width = (width + padding) // 3
+	rows = [encode_row(triplets[r * row_width:(r + 1) * row_width]) for r in range(height)]
+
+	# the table of row offsets
+	offset = 0
+	for r in range(height):
+		fileout.write('0x{0:02x},0x{1:02x},'.format(offset & 0xff, (offset >> 8) & 0xff))
+		if (r % 8 == 7):
+			fileout.write('\n\t')
+		offset += len(rows[r])
+	fileout.write('\n\t')
+
+	for r in range(height):
+		fileout.write(''.join('0x{0:02x},'.format(b) for b in rows[r]))
+		fileout.write(' // row {0}\n'.format(r))
+		if (r < height - 1):
+			fileout.write('\t')
+		countw += len(rows[r])
+	countw += height * 2
+	fileout.write('};')
+else:
+	countRLE = 0 # count number of same bytes
+	prev_char = 4 # hold value of current running length (4 is an impossible value in the context)
+
+	for pix in triplets:
 		if pix != prev_char:
 			if countRLE != 0: # if we are not starting encoding write the previous running length
 				fileout.write('0X{0:02X},0x{1:02x},'.format(countRLE, prev_char)) # write the byte to the file in ascii hex
@@ -169,7 +241,6 @@ for byte in data:
 
 			countRLE = 1 # restart RLE count
 			prev_char = pix # new pix we are counting
-			first = 0
 		else:
 			countRLE +=1
 			if countRLE==254: # if running length is to roll over write value and reset count
@@ -180,8 +251,8 @@ for byte in data:
 				countRLE = 0
 
 
-fileout.write('0X{0:02X},0x{1:02x},'.format(countRLE, prev_char))
-fileout.write('0X00,0x00\n};')
+	fileout.write('0X{0:02X},0x{1:02x},'.format(countRLE, prev_char))
+	fileout.write('0X00,0x00\n};')
 
 fileout.write('\n')
 fileout.write('// Total bytes from original bitmap: %d\n' % (count))
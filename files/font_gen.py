@@ -56,6 +56,21 @@ This results in the need to make a font taller than it would otherwise need to b
 forces the underscore to the bottom most available row of the font. This hack means its OK to clip the bottom of the
 font, if the only thing that will be lost is the underscore.
 
+### Triplet Fonts
+
+`python3 font_gen.py --triplets` outputs each font pre-packed as SRXE triplets, including the padding, in a `font_<W>X<H>T.h` file.
+Each triplet byte is a 2-bit mask per pixel (`11` is foreground) in the LCD `bbxbbxbb` layout.
+The text renderer applies the colors with an AND/OR per byte and streams the glyph straight from PROGMEM.
+Use `FONT_TRIPLETS` in the `lcdFontConfig()` scale parameter for these fonts.
+
+The program reports the FLASH cost of each font in both formats. Triplet fonts use 2 to 3 times the FLASH.
+The speed of the two formats is measured by the `triplets` lines of `lcd_bench` _(see `files/srxe_emulator`)_.
+On the host, up to 8 pixels wide the 1-bit font is expanded a whole row at a time with a color table and the two
+formats are about the same speed; at 12 pixels wide the `triplets_12x18` line measures the triplet font 1.12x to 1.29x faster.
+A single run on a busy host can fall outside this range, so compare several runs.
+
+Triplet fonts can not be doubled in width. Generally, a triplet font is only worth the FLASH for a wide font used for a lot of text.
+
 The `font_gen.py` program is based on the work by Jared Sanson (jared@jared.geek.nz).
 This program requires `PIL` (Python Imaging Library) to generate a `PNG` of the characters.
 The `PNG` is chunked to make the bitmaps for each character.
@@ -68,6 +83,26 @@ Only the characters from SPACE (32) through Tilda (127) are rasterized.
 
 from PIL import Image, ImageFont, ImageDraw
 import os.path
+import argparse
+
+parser = argparse.ArgumentParser(description='generate SRXEcore font header files')
+parser.add_argument('--triplets', action='store_true', help='output pre-packed triplet fonts (FONT_TRIPLETS)')
+parser.add_argument('--version', action='version', version='%(prog)s 1.1')
+args = parser.parse_args()
+
+
+def pack_triplets(pixels):
+	# pack one row of pixels (True = foreground) into triplet masks; padding to the triplet boundary is background
+	# with a padding of 2, one pixel goes before and one after the glyph (to match the SRXEcore text renderer)
+	padding = (3 - (len(pixels) % 3)) % 3
+	if padding == 2:
+		pixels = [False] + pixels + [False]
+	else:
+		pixels = pixels + ([False] * padding)
+	masks = []
+	for i in range(0, len(pixels), 3):
+		masks.append((0xc0 if pixels[i] else 0) | (0x18 if pixels[i+1] else 0) | (0x03 if pixels[i+2] else 0))
+	return masks
 
 FONT_DIR = "./"
 
@@ -100,6 +135,12 @@ for FONT in FONTS:
 
 	FONTSTR = ''.join(chr(x) for x in range(ord(FONT_BEGIN), ord(FONT_END)+1))
 
+	CHAR_TRIPLETS = int((CHAR_WIDTH + ((3 - (CHAR_WIDTH % 3)) % 3)) / 3)	# triplets per row including the padding
+	CHAR_WIDTHBYTES = int((CHAR_WIDTH + 7) / 8)
+
+	if args.triplets:
+		FONT_DEFINE = FONT_DEFINE + 'T'
+
 	OUTPUT_NAME = 'font_' + FONT_DEFINE
 	OUTPUT_PNG = OUTPUT_NAME + '.png'
 	OUTPUT_H = OUTPUT_NAME + '.h'
@@ -130,14 +171,23 @@ for FONT in FONTS:
 	# f.write('#define FONT_%s %s\n\n' % (FONT_DEFINE.upper(), FONT_DEFINE.upper()))
 	f.write('#define FONT_%s_WIDTH %d\n' % (FONT_DEFINE.upper(), CHAR_WIDTH))
 	f.write('#define FONT_%s_HEIGHT %d\n' % (FONT_DEFINE.upper(), CHAR_HEIGHT))
-	f.write('#define FONT_%s_WIDTHBYTES %d\n' % (FONT_DEFINE.upper(), int((CHAR_WIDTH + 7) / 8)))
-	f.write('#define FONT_%s_CHARBYTES %d\n' % (FONT_DEFINE.upper(), (int((CHAR_WIDTH + 7) / 8) * CHAR_HEIGHT)))
-	f.write('\n')
-	f.write('// NOTE: Data is width (bits) first by height (bits) to match the SRXE LCD processing.\n')
-	f.write('//       The bits are stored where the low bit is the left most pixel to be easier for SRXE processing.\n')
-	f.write('//       This has the positive of being flexible for any font and the negative of using more data space.\n')
-	f.write('//       Ideally for data size, the font width would be a multiple of 8, but LCD wants font width to be a multiple of 3.\n')
-	f.write('\n')
+	if args.triplets:
+		f.write('#define FONT_%s_WIDTHBYTES %d\n' % (FONT_DEFINE.upper(), CHAR_TRIPLETS))
+		f.write('#define FONT_%s_CHARBYTES %d\n' % (FONT_DEFINE.upper(), CHAR_TRIPLETS * CHAR_HEIGHT))
+		f.write('\n')
+		f.write('// NOTE: Data is pre-packed SRXE triplets; use FONT_TRIPLETS with lcdFontConfig().\n')
+		f.write('//       Each byte is a 2-bit mask per pixel (11 = foreground) for three pixels in the LCD bbxbbxbb layout.\n')
+		f.write('//       The WIDTHBYTES is the number of triplets in a row, including the padding to the triplet boundary.\n')
+		f.write('\n')
+	else:
+		f.write('#define FONT_%s_WIDTHBYTES %d\n' % (FONT_DEFINE.upper(), CHAR_WIDTHBYTES))
+		f.write('#define FONT_%s_CHARBYTES %d\n' % (FONT_DEFINE.upper(), (CHAR_WIDTHBYTES * CHAR_HEIGHT)))
+		f.write('\n')
+		f.write('// NOTE: Data is width (bits) first by height (bits) to match the SRXE LCD processing.\n')
+		f.write('//       The bits are stored where the low bit is the left most pixel to be easier for SRXE processing.\n')
+		f.write('//       This has the positive of being flexible for any font and the negative of using more data space.\n')
+		f.write('//       Ideally for data size, the font width would be a multiple of 8, but LCD wants font width to be a multiple of 3.\n')
+		f.write('\n')
 
 	f.write('\nconst unsigned char font_' + FONT_DEFINE + '_P [] PROGMEM = {\n')
 
@@ -149,12 +199,16 @@ for FONT in FONTS:
 			x = 0
 			offset = i*GLYPH_WIDTH
 			shift = 0
+			pixels = []
 
 			for j in range(CHAR_WIDTH):
 				# if we are on the last row of the underscore, force the pixels
 				rgb = img.getpixel((j+offset,y))
 				if (y == (CHAR_HEIGHT - 1)) and (i == (95 - 32)) and (j != 0):
 					rgb = [0, 0, 0]
+				pixels.append(rgb[0] < 127)
+				if args.triplets:
+					continue
 				val = val | ((1 << shift) if rgb[0] < 127 else 0)
 				shift += 1
 				if shift % 8 == 0:
@@ -169,6 +223,9 @@ for FONT in FONTS:
 				val = 0
 				shift = 0
 
+			if args.triplets:
+				ints.extend(['0x%.2x' % (m) for m in pack_triplets(pixels)])
+
 		c = FONTSTR[i]
 		if c == '\\': c = '"\\"' # bugfix
 
@@ -181,3 +238,8 @@ for FONT in FONTS:
 	# f.write('\n')
 
 	f.close()
+
+	# report the FLASH cost of each format so the choice can be made per font
+	bits_size = CHAR_WIDTHBYTES * CHAR_HEIGHT * num_chars
+	triplets_size = CHAR_TRIPLETS * CHAR_HEIGHT * num_chars
+	print('%s: %dx%d 1-bit %d bytes, triplets %d bytes (%.1fx FLASH)' % (OUTPUT_H, CHAR_WIDTH, CHAR_HEIGHT, bits_size, triplets_size, float(triplets_size) / bits_size))
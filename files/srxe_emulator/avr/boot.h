@@ -0,0 +1,2 @@
+// host replacement for <avr/boot.h>
+#define boot_signature_byte_get(a) ((uint8_t)(0x1e + (a)))
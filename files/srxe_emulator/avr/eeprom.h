@@ -0,0 +1 @@
+// host replacement for <avr/eeprom.h>
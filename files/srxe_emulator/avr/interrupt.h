@@ -0,0 +1,6 @@
+// host replacement for <avr/interrupt.h>
+// an ISR is an ordinary function which the emulator calls directly
+#include "io.h"
+#define ISR(vector) void vector(void)
+#define sei() ((void)0)
+#define cli() ((void)0)
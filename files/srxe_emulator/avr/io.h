@@ -0,0 +1,135 @@
+/* ************************************************************************************
+* File:    avr/io.h (emulator shim)
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+// host replacement for <avr/io.h>
+// registers are plain variables except SPDR and SPSR which drive the emulated SPI bus
+
+#ifndef __SRXE_EMU_AVR_IO_
+#define __SRXE_EMU_AVR_IO_
+
+#include <stdint.h>
+
+// bit positions used by the SRXEcore
+#define PIN0 0
+#define PIN1 1
+#define PIN2 2
+#define PIN3 3
+#define PIN4 4
+#define PIN5 5
+#define PIN6 6
+#define PIN7 7
+
+#define SPIE	7
+#define SPE		6
+#define MSTR	4
+#define SPIF	7
+#define WCOL	6
+#define SPI2X	0
+
+#define PORTD2	2
+#define PF7		7
+#define DDF7	7
+#define INT2	2
+#define INTF2	2
+#define ISC20	4
+#define ISC21	5
+
+#define CS01	1
+#define CS20	0
+#define CS21	1
+#define CS22	2
+#define WGM01	1
+#define WGM21	1
+#define OCF0A	1
+#define OCF2A	1
+#define OCIE2A	1
+#define CS40	0
+#define CS41	1
+#define WGM42	3
+#define OCF4A	1
+#define OCIE4A	1
+
+#define ADSC	6
+#define EEMPE	2
+#define EEPE	1
+#define EERE	0
+
+// transceiver bits and states
+#define SLPTR			1
+#define TRXRST			0
+#define TX_AUTO_CRC_ON	5
+#define RX_START_EN		2
+#define RX_END_EN		3
+#define TX_END_EN		6
+#define RX_CRC_VALID	7
+#define TX_PWR0			0
+#define TX_PWR1			1
+#define TX_PWR2			2
+#define TX_PWR3			3
+#define CMD_TX_START		0x02
+#define CMD_FORCE_TRX_OFF	0x03
+#define CMD_FORCE_PLL_ON	0x04
+#define RX_ON			0x06
+#define TRX_OFF			0x08
+#define PLL_ON			0x09
+#define SLEEP			0x0F
+#define STATE_TRANSITION_IN_PROGRESS 0x1F
+#define CMD_RX_ON		0x06
+#define CMD_PLL_ON		0x09
+#define CMD_RX_AACK_ON	0x16
+#define CMD_TX_ARET_ON	0x19
+#define BUSY_RX			0x01
+#define BUSY_TX			0x02
+#define BUSY_RX_AACK	0x11
+#define BUSY_TX_ARET	0x12
+#define RX_AACK_ON		0x16
+#define TX_ARET_ON		0x19
+#define RX_END			3
+#define MAX_CSMA_RETRIES0	1
+#define MAX_FRAME_RETRIES0	4
+
+#define _EMU_REG(n) extern volatile uint8_t n;
+_EMU_REG(PINB) _EMU_REG(PIND) _EMU_REG(PINE) _EMU_REG(PINF) _EMU_REG(PING)
+_EMU_REG(PORTB) _EMU_REG(PORTD) _EMU_REG(PORTE) _EMU_REG(PORTF) _EMU_REG(PORTG)
+_EMU_REG(DDRB) _EMU_REG(DDRD) _EMU_REG(DDRE) _EMU_REG(DDRF) _EMU_REG(DDRG)
+_EMU_REG(SPCR) _EMU_REG(SREG)
+_EMU_REG(TCCR0A) _EMU_REG(TCCR0B) _EMU_REG(TCCR2A) _EMU_REG(TCCR2B) _EMU_REG(TCNT0) _EMU_REG(TCNT2)
+_EMU_REG(TIMSK0) _EMU_REG(TIMSK2) _EMU_REG(TIFR2) _EMU_REG(OCR0A) _EMU_REG(OCR2A)
+_EMU_REG(TCCR4A) _EMU_REG(TCCR4B) _EMU_REG(TIMSK4) _EMU_REG(TIFR4)
+extern volatile uint16_t TCNT4;
+extern volatile uint16_t OCR4A;
+_EMU_REG(ADCH) _EMU_REG(ADCL) _EMU_REG(ADCSRA) _EMU_REG(ADCSRB) _EMU_REG(ADCSRC) _EMU_REG(ADMUX)
+_EMU_REG(EEAR) _EMU_REG(EECR) _EMU_REG(EEDR)
+_EMU_REG(EICRA) _EMU_REG(EIFR) _EMU_REG(EIMSK)
+_EMU_REG(TRXPR) _EMU_REG(TRX_STATE) _EMU_REG(TRX_STATUS) _EMU_REG(TRX_CTRL_1) _EMU_REG(IRQ_MASK)
+_EMU_REG(PHY_CC_CCA) _EMU_REG(PHY_RSSI) _EMU_REG(PHY_TX_PWR) _EMU_REG(TST_RX_LENGTH)
+_EMU_REG(IRQ_STATUS) _EMU_REG(PAN_ID_0) _EMU_REG(PAN_ID_1) _EMU_REG(SHORT_ADDR_0) _EMU_REG(SHORT_ADDR_1) _EMU_REG(XAH_CTRL_0) _EMU_REG(CSMA_SEED_0)
+
+extern volatile uint8_t _emu_trx_frame_buffer[129];
+#define TRXFBST (_emu_trx_frame_buffer[0])
+
+// SPI data register - a write starts a byte on the emulated bus
+struct _emu_spdr_reg {
+	uint8_t value;
+	_emu_spdr_reg &operator=(uint8_t b);
+	operator uint8_t() const { return value; }
+};
+
+// SPI status register - the emulated bus completes each byte immediately so SPIF always reads as set
+struct _emu_spsr_reg {
+	uint8_t value;
+	_emu_spsr_reg &operator=(uint8_t b) { value = b; return *this; }
+	_emu_spsr_reg &operator|=(uint8_t b) { value |= b; return *this; }
+	operator uint8_t() const { return value | (1 << SPIF); }
+};
+
+extern _emu_spdr_reg SPDR;
+extern _emu_spsr_reg SPSR;
+
+#endif // __SRXE_EMU_AVR_IO_
@@ -0,0 +1,16 @@
+// host replacement for <avr/pgmspace.h>
+// program memory is ordinary memory on the host
+#ifndef __SRXE_EMU_AVR_PGMSPACE_
+#define __SRXE_EMU_AVR_PGMSPACE_
+#include <stdint.h>
+#include <string.h>
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p)		(*(const uint8_t *)(p))
+#define pgm_read_byte_near(p)	(*(const uint8_t *)(p))
+#define pgm_read_word(p)		(*(const uint16_t *)(p))
+#define pgm_read_word_near(p)	(*(const uint16_t *)(p))
+#define pgm_read_ptr(p)			(*(void *const *)(p))
+#define memcpy_P	memcpy
+#define strlen_P	strlen
+#endif
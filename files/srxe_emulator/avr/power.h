@@ -0,0 +1,2 @@
+// host replacement for <avr/power.h>
+#include "io.h"
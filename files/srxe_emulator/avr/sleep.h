@@ -0,0 +1,6 @@
+// host replacement for <avr/sleep.h>
+#define SLEEP_MODE_PWR_DOWN 0
+#define set_sleep_mode(m)	((void)0)
+#define sleep_enable()		((void)0)
+#define sleep_disable()		((void)0)
+#define sleep_cpu()			((void)0)
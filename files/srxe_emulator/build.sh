@@ -0,0 +1,8 @@
+#!/bin/bash
+# build the LCD emulator benchmark and the RF star and RF transfer simulators on the host
+# usage: ./build.sh [path-to-srxecore-src] [extra compiler flags, eg: -DLCD_ASYNC_QUEUE]
+cd "$(dirname "$0")"
+SRC=${1:-../../src}
+g++ -std=gnu++11 -O2 -Wall -Wextra -I. -I"$SRC" -DCHIP_ATMEGA128RFA1 -o lcd_bench lcd_bench.cpp "${@:2}"
+g++ -std=gnu++11 -O2 -Wall -Wextra -I. -I"$SRC" -DCHIP_ATMEGA128RFA1 -o rf_star_sim rf_star_sim.cpp "${@:2}"
+g++ -std=gnu++11 -O2 -Wall -Wextra -I. -I"$SRC" -o rf_transfer_sim rf_transfer_sim.cpp "${@:2}"
@@ -0,0 +1,717 @@
+/* ************************************************************************************
+* File:    lcd_bench.cpp
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+### LCD Draw Cost Benchmark
+
+`lcd_bench` runs a fixed set of draw operations against the emulator and reports, per operation:
+ - **cmd** - command bytes and their parameters _(the address setup overhead)_
+ - **pixels** - data bytes written to the display RAM
+ - **windows** - memory write (`0x2c`) commands
+ - **bus** - the simulated SPI bus time in microseconds
+
+After each operation the visible screen is written as a PGM file to the output folder.
+Each screen is then compared pixel-for-pixel with the golden PGM of the same name.
+The program exits non-zero if any screen differs or has no golden.
+
+The `golden` folder holds the screens of the current code. A change which is not meant to alter the output must
+still match them. When a change is meant to alter the output, check the new screens by eye and copy them to `golden`.
+
+The `glyphs` line draws every printable character of the default fonts, and of synthetic fonts 4 to 16 pixels wide,
+at every scale and in every fg/bg pair, and compares each with the per-bit expansion of the original `lcdPutChar()`.
+Any difference is a failure.
+
+The `text_speed` lines time `lcdPutString()` on the host with the model switched off _(the best of 5 runs)_.
+They are only meaningful when compared with another build on the same computer.
+
+The `mgl_pixels` line draws each line and circle of the `mgl_lines` and `mgl_circles` screens on its own, and the
+circles together, through micro_gl and compares every pixel with a rasterization computed in the benchmark.
+Any difference is a failure. Shapes drawn together can lose pixels where a later shape crosses a triplet which has left
+the span cache _(see `mgl_srxe.h`)_; the lines of `mgl_lines` do.
+
+The `triplets` lines pack a 1-bit font as triplets, the same as `font_gen.py --triplets`, and report
+the FLASH each format needs and the host speed of each. The two must draw the same for every fg/bg pair,
+both normal and doubled in height.
+
+### Usage
+
+`./build.sh` then `./lcd_bench` [_output-folder_] [_golden-folder_]
+
+|PARAMETER|DESCRIPTION|
+|:-----|:-----|
+|output folder|where PGM screenshots are written (default `screens`)|
+|golden folder|the folder of PGM screenshots from a known good build (default `golden`)|
+
+--------------------------------------------------------------------------
+--- */
+
+#include <stdlib.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "srxe_emulator.h"
+
+// RAM is not a concern on the host so the optional features with screens of their own are always included
+#ifndef LCD_SHADOW
+#define LCD_SHADOW
+#endif
+#ifndef LCD_TILES
+#define LCD_TILES
+#endif
+
+#include "_avr_includes.h"
+#include "_srxe_includes.h"
+
+#include "menu_ball18_v2.h"	// the menu ball as a version 2 bitmap (bitmap_gen.py --v2)
+#include "micro_gl/micro_gl.h"
+
+// printf.h redirects these to its own implementations; the host versions are used here
+#undef printf
+#undef sprintf
+#undef snprintf
+
+static const char *_bench_out = "screens";
+static const char *_bench_golden = "golden";
+static int _bench_failures = 0;
+
+static const char *_bench_menus[] = {"Left1", "Left2", NULL, "Left4", NULL, "Right1", NULL, "Right3", NULL, "Right5"};
+
+typedef void (*BENCH_FUNC)(void);
+
+static void bench_run(const char *name, BENCH_FUNC setup, BENCH_FUNC operation, int repeat) {
+	char filename[256];
+
+	if (setup)
+		setup();
+	emuLcdCountersReset();
+	for (int i = 0; i < repeat; i++)
+		operation();
+	EMU_COUNTERS c = emuLcdCounters();
+
+	uint32_t cmd = c.command_bytes + (c.data_bytes - c.pixel_bytes);	// commands and their parameters
+	uint32_t total = c.command_bytes + c.data_bytes + c.flash_bytes;
+	printf("%-24s %8.1f %8.1f %8.1f %10.1f", name,
+		   (double)cmd / repeat, (double)c.pixel_bytes / repeat, (double)c.windows / repeat,
+		   ((double)total * EMU_SPI_BYTE_NS / 1000.0) / repeat);
+	if (c.flash_bytes)	// the sustained rate of pixel data, including the FLASH reads
+		printf("  %.0f KB/s", ((double)c.pixel_bytes / 1024.0) / ((double)total * EMU_SPI_BYTE_NS / 1e9));
+
+	snprintf(filename, sizeof(filename), "%s/%s.pgm", _bench_out, name);
+	emuLcdSavePGM(filename);
+
+	snprintf(filename, sizeof(filename), "%s/%s.pgm", _bench_golden, name);
+	long diffs = emuLcdComparePGM(filename);
+	if (diffs < 0)
+		printf("  (no golden)");
+	else if (diffs)
+		printf("  DIFFERS: %ld pixels", diffs);
+	if (diffs)
+		_bench_failures++;
+	printf("\n");
+}
+
+// --------------------------------------------------------------------------------------------
+
+static void clear_white() {
+	lcdColorSet(LCD_BLACK, LCD_WHITE);
+	lcdClearScreen();
+}
+
+static void op_fill() { lcdFill(0x92); }
+
+static void op_rect_filled() {
+	lcdColorSet(LCD_BLACK, LCD_LIGHT);
+	lcdRectangle(10, 20, 60, 50, LCD_FILLED);
+}
+
+static void op_rect_hollow() {
+	lcdColorSet(LCD_BLACK, LCD_WHITE);
+	lcdRectangle(40, 30, 50, 60, LCD_HOLLOW);
+}
+
+static void op_rect_erase() {
+	lcdColorSet(LCD_BLACK, LCD_DARK);
+	lcdRectangle(5, 5, 30, 30, LCD_ERASE);
+}
+
+// a hollow and a filled table; drawn as grids and cell by cell for the same screen
+static void op_grid(bool cells) {
+	lcdColorSet(LCD_BLACK, LCD_LIGHT);
+	for (int mode = LCD_HOLLOW; mode <= LCD_FILLED; mode++) {
+		int y = (mode == LCD_HOLLOW) ? 10 : 70;
+		if (!cells) {
+			lcdRectangleGrid(4, y, 4, 3, 20, 16, mode);
+			continue;
+		}
+		for (int r = 0; r < 3; r++)
+			for (int c = 0; c < 4; c++)
+				lcdRectangle(4 + (c * 20), y + (r * 16), 20, 16, mode);
+	}
+}
+static void op_grid_table() { op_grid(false); }
+static void op_grid_cells() { op_grid(true); }
+
+// grids clipped at the right and bottom edges, and one below the screen which must draw nothing
+static void op_grid_clip() {
+	lcdColorSet(LCD_BLACK, LCD_LIGHT);
+	lcdRectangleGrid(90, 4, 4, 2, 12, 10, LCD_HOLLOW);
+	lcdRectangleGrid(4, 110, 3, 4, 14, 12, LCD_FILLED);
+	lcdRectangleGrid(10, 140, 2, 2, 4, 4, LCD_FILLED);
+}
+
+static void op_lines() {
+	lcdColorSet(LCD_BLACK, LCD_WHITE);
+	lcdHorizontalLine(4, 100, 120, 2);
+	lcdVerticalLine(64, 10, 120, 1);
+	lcdVerticalLine(66, 10, 120, 2);
+	lcdVerticalLine(68, 10, 120, 3);
+}
+
+static void op_bitmap() { lcdBitmap(50, 50, menu_ball18, false); }
+
+static void op_bitmap_v2() { lcdBitmap(50, 50, menu_ball18_v2, false); }
+
+// the same parts of both versions; partly off the left and bottom edges and a slice from the middle
+static void op_bitmap_clip(const uint8_t *bitmap) {
+	lcdBitmapClip(-2, 10, bitmap, 0, 0, 6, 18, false);
+	lcdBitmapClip(20, LCD_HEIGHT - 9, bitmap, 0, 0, 6, 18, true);
+	lcdBitmapClip(40, 40, bitmap, 1, 5, 4, 8, false);
+}
+static void op_bitmap_clip_v1() { op_bitmap_clip(menu_ball18); }
+static void op_bitmap_clip_v2() { op_bitmap_clip(menu_ball18_v2); }
+
+static void op_text(uint8_t font) {
+	lcdFontSet(font);
+	lcdColorSet(LCD_BLACK, LCD_WHITE);
+	lcdPutStringAt("The quick brown fox!", 0, 40);
+}
+static void op_text_font1() { op_text(FONT1); }
+static void op_text_font2() { op_text(FONT2); }
+static void op_text_font3() { op_text(FONT3); }
+static void op_text_font4() { op_text(FONT4); }
+
+static void op_text_grey() {
+	lcdFontSet(FONT2);
+	lcdColorSet(LCD_DARK, LCD_LIGHT);
+	lcdPutStringAt("Grey {text} 0123", 7, 70);
+}
+
+static void op_menu() { uiMenu(_bench_menus, "Title", UI_MENU_ROUND_END, true); }
+
+static void op_menu_rounded() { uiMenu(_bench_menus, NULL, UI_MENU_ROUNDED, true); }
+
+static void op_menu_rectangle() { uiMenu(_bench_menus, NULL, UI_MENU_RECTANGLE, true); }
+
+// the status line is drawn on the hidden page and must only appear after the flip
+static void op_page_flip() {
+	lcdPageFlipBegin(16);
+	lcdFontSet(FONT2);
+	lcdColorSet(LCD_BLACK, LCD_LIGHT);
+	lcdRectangle(0, LCD_HEIGHT - 16, LCD_WIDTH, 16, LCD_FILLED);
+	lcdPutStringAt("Status: back page", 2, LCD_HEIGHT - 14);
+	lcdPageFlip();
+}
+
+// a full console with a title and a soft menu line; the operation adds one line
+static int _bench_console_count;
+
+static void console_full() {
+	clear_white();
+	lcdFontSet(FONT1);
+	lcdPutStringAt("Console", 0, 0);
+	lcdPutStringAt("Menu", 0, LCD_HEIGHT - 8);
+	lcdConsoleBegin(10, 10);
+	for (_bench_console_count = 0; _bench_console_count < 20; _bench_console_count++)
+		printDevicePrintf(PRINT_LCD, "line %d\n", _bench_console_count);
+}
+
+static void op_console_line() { printDevicePrintf(PRINT_LCD, "line %d\n", _bench_console_count++); }
+
+// overlapping shapes and an XOR cursor which only the shadow can draw
+static void shadow_scene() {
+	clear_white();
+	lcdColorSet(LCD_BLACK, LCD_WHITE);
+	lcdShadowClear();
+	lcdShadowRectangle(10, 10, 100, 60, LCD_FILLED, LCD_SHADOW_SET);
+	lcdShadowRectangle(60, 40, 100, 60, LCD_FILLED, LCD_SHADOW_XOR);
+	lcdFontSet(FONT2);
+	lcdShadowPutString("Shadow", 20, 80, LCD_SHADOW_XOR);
+	lcdShadowFlush();
+}
+
+static void op_shadow_cursor() {
+	lcdShadowRectangle(101, 20, 2, 16, LCD_FILLED, LCD_SHADOW_XOR);
+	lcdShadowFlush();
+}
+
+#ifdef LCD_BAND
+// a cursor over a bitmap over a box; the overlapping shapes are sent once (build with -DLCD_BAND)
+static void op_band() {
+	lcdBandBegin(LCD_WHITE);
+	lcdColorSet(LCD_BLACK, LCD_LIGHT);
+	lcdBandRectangle(20, 30, 40, 40, LCD_FILLED);
+	lcdBandBitmap(30, 40, menu_ball18, false);
+	lcdFontSet(FONT2);
+	lcdColorSet(LCD_WHITE, LCD_DARK);
+	lcdBandText("Band", 34, 44);
+	lcdColorSet(LCD_BLACK, LCD_BLACK);
+	lcdBandRectangle(45, 44, 1, 12, LCD_ERASE);
+	lcdBandRender();
+}
+#endif
+
+// four tiles of 4 triplets by 8 rows: blank, brick, grey, and a ball sprite on a white key
+#define _T4(v)	v, v, v, v
+static const uint8_t _bench_tiles[] PROGMEM = {
+	_T4(0x00), _T4(0x00), _T4(0x00), _T4(0x00), _T4(0x00), _T4(0x00), _T4(0x00), _T4(0x00),
+	_T4(0xff), 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, _T4(0x00), _T4(0xff), 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, _T4(0x00),
+	_T4(0x92), _T4(0x25), _T4(0x92), _T4(0x25), _T4(0x92), _T4(0x25), _T4(0x92), _T4(0x25),
+	0x00, 0x1f, 0xfc, 0x00, 0x03, 0xff, 0xff, 0xe0, 0x1f, 0xff, 0xff, 0xfc, 0x1f, 0x92, 0x92, 0xfc,
+	0x1f, 0x92, 0x92, 0xfc, 0x1f, 0xff, 0xff, 0xfc, 0x03, 0xff, 0xff, 0xe0, 0x00, 0x1f, 0xfc, 0x00,
+};
+
+// a map twice the width of the screen; the operation scrolls it one column and moves the sprite
+static uint8_t _bench_map[16][64];
+
+static void tiles_scene() {
+	clear_white();
+	for (int r = 0; r < 16; r++)
+		for (int c = 0; c < 64; c++)
+			_bench_map[r][c] = (r >= 13) ? 1 : ((((c * 7) + (r * 3)) % 11) == 0) ? 2 : (((r == 9) && ((c % 8) < 3)) ? 1 : 0);
+	lcdTilesSetP(_bench_tiles, 4, 8);
+	lcdTilesBegin(0, 4, 32, 16);
+	lcdTilesMap(&_bench_map[0][0], 64, 16);
+	lcdTilesSpriteKey(LCD_WHITE);
+	lcdTilesSprite(0, 30, 92, 3);
+	lcdTilesRender();
+}
+
+static void op_tiles_scroll() {
+	lcdTilesView(1, 0);
+	lcdTilesSprite(0, 31, 90, 3);
+	lcdTilesRender();
+}
+
+static void op_tiles_sprite() {
+	lcdTilesSprite(0, 31, 90, 3);
+	lcdTilesRender();
+}
+
+// images in the FLASH: the menu ball as a version 1 bitmap and an uncompressed grey ramp
+#define _BENCH_FLASH_BALL	0x1000
+#define _BENCH_FLASH_RAMP	0x2000
+
+static void flash_scene() {
+	uint8_t ramp[40 * 48];
+	for (int r = 0; r < 48; r++)
+		for (int c = 0; c < 40; c++)
+			ramp[(r * 40) + c] = _lcd_color_to_byte[((c / 10) + (r / 12)) & 0x3];
+	emuFlashLoad(_BENCH_FLASH_BALL, menu_ball18, sizeof(menu_ball18));
+	emuFlashLoad(_BENCH_FLASH_RAMP, ramp, sizeof(ramp));
+	clear_white();
+}
+
+// the same screen as the "bitmap" case
+static void op_flash_bitmap() { lcdBitmapFlash(50, 50, _BENCH_FLASH_BALL, false); }
+
+// whole and clipped blits
+static void op_flash_blit() {
+	lcdBlitFlash(10, 10, 40, 48, _BENCH_FLASH_RAMP);
+	lcdBlitFlash(-20, 80, 40, 48, _BENCH_FLASH_RAMP);
+	lcdBlitFlash(100, 100, 40, 48, _BENCH_FLASH_RAMP);
+}
+
+// a micro_gl form; the update changes one property of each widget and only the differences are drawn
+static const char *_bench_items[] = {"Apple", "Banana", "Cherry", "Date", "Elder", "Fig"};
+static MGL_ID _bench_label, _bench_button, _bench_list, _bench_progress;
+
+static void op_mgl_form() {
+	mglReset();
+	lcdFontSet(FONT2);
+	MGL_ID panel = mglPanel(MGL_NONE, 10, 10, 100, 110, true);
+	_bench_label = mglLabel(panel, 4, 6, 60, "Status: ready");
+	_bench_button = mglButton(panel, 4, 28, 30, 20, "OK");
+	_bench_list = mglList(panel, 40, 28, 40, 50, _bench_items, 6);
+	_bench_progress = mglProgress(panel, 4, 88, 90, 12, 100);
+	mglSetValue(_bench_progress, 30);
+	mglSetValue(_bench_list, 1);
+	mglRender();
+}
+
+static void op_mgl_update() {
+	mglSetText(_bench_label, "Status: ok");
+	mglSetFlag(_bench_button, MGL_FOCUSED, true);
+	mglSetValue(_bench_list, 2);
+	mglSetValue(_bench_progress, 60);
+	mglRender();
+}
+
+// the button is removed; it is covered with the panel
+static void op_mgl_delete() {
+	mglDelete(_bench_button);
+	mglRender();
+}
+
+// lines and circles through the micro_gl pixel hook; the pixels are collected in row spans
+static void op_mgl_lines() {
+	for (int i = 0; i <= 8; i++) {
+		mglLine(20, 20, 20 + (i * 40), 130, LCD_BLACK, LCD_WHITE);
+		mglLine(360, 20, 360 - (i * 40), 130, LCD_DARK, LCD_WHITE);
+	}
+	mglFlush();
+}
+
+static void op_mgl_circles() {
+	for (int r = 8; r <= 60; r += 13)
+		mglCircle(190, 68, r, LCD_BLACK, LCD_WHITE);
+	mglCircle(60, 40, 20, LCD_DARK, LCD_WHITE);
+	mglCircle(320, 100, 20, LCD_DARK, LCD_WHITE);
+	mglFlush();
+}
+
+// --------------------------------------------------------------------------------------------
+// micro_gl lines and circles compared pixel-for-pixel with a rasterization computed here
+
+static uint8_t _bench_raster[EMU_VISIBLE_HEIGHT][EMU_RAM_WIDTH];
+
+static void raster_pixel(int x, int y, uint8_t color) {
+	static const uint8_t masks[3] = {0b11100000, 0b00011100, 0b00000011};
+	if ((x < 0) || (y < 0) || (x >= (EMU_RAM_WIDTH * 3)) || (y >= EMU_VISIBLE_HEIGHT))
+		return;
+	uint8_t *p = &_bench_raster[y][x / 3];
+	*p = (*p & ~masks[x % 3]) | (_lcd_color_to_byte[color] & masks[x % 3]);
+}
+
+// every pixel nearest the line, stepping along its longer axis; the same pixels as a Bresenham line
+static void raster_line(int x0, int y0, int x1, int y1, uint8_t color) {
+	int dx = x1 - x0, dy = y1 - y0;
+	int steps = (abs(dx) > abs(dy)) ? abs(dx) : abs(dy);
+	for (int i = 0; i <= steps; i++) {
+		// round half away from the start, as the error term of the line does
+		int nx = 2 * dx * i, ny = 2 * dy * i;
+		int x = x0 + (steps ? ((nx + ((nx < 0) ? -steps : steps)) / (2 * steps)) : 0);
+		int y = y0 + (steps ? ((ny + ((ny < 0) ? -steps : steps)) / (2 * steps)) : 0);
+		raster_pixel(x, y, color);
+	}
+}
+
+// for each step of the first octant the x whose x*x + y*y is nearest r*r from above, mirrored into the others
+static void raster_circle(int cx, int cy, int r, uint8_t color) {
+	for (int y = 0; ; y++) {
+		int x = r;
+		while ((x > 0) && ((4 * ((x - 1) * (x - 1) + y * y)) >= ((4 * r * r) - (4 * (x - 1)) - 3)))
+			x--;
+		if (x < y)
+			break;
+		int points[8][2] = {{x, y}, {y, x}, {-y, x}, {-x, y}, {-x, -y}, {-y, -x}, {y, -x}, {x, -y}};
+		for (int i = 0; i < 8; i++)
+			raster_pixel(cx + points[i][0], cy + points[i][1], color);
+	}
+}
+
+static long raster_compare() {
+	long differ = 0;
+	for (int y = 0; y < EMU_VISIBLE_HEIGHT; y++)
+		for (int x = 0; x < (EMU_RAM_WIDTH * 3); x++) {
+			static const uint8_t masks[3] = {0b11100000, 0b00011100, 0b00000011};
+			uint8_t m = masks[x % 3];
+			if ((_emu_lcd.ram[y][x / 3] & m) != (_bench_raster[y][x / 3] & m))
+				differ++;
+		}
+	return differ;
+}
+
+// each line and circle of the mgl_lines and mgl_circles scenes drawn alone, then the circles drawn together
+static void bench_mgl_pixels() {
+	long shapes = 0, differ = 0;
+
+	for (int shape = 0; shape < 27; shape++) {
+		clear_white();
+		memset(_bench_raster, _lcd_color_to_byte[LCD_WHITE], sizeof(_bench_raster));
+		if (shape < 18) {
+			int i = shape / 2;
+			int x0 = (shape & 1) ? 360 : 20;
+			int x1 = (shape & 1) ? (360 - (i * 40)) : (20 + (i * 40));
+			uint8_t color = (shape & 1) ? LCD_DARK : LCD_BLACK;
+			mglLine(x0, 20, x1, 130, color, LCD_WHITE);
+			raster_line(x0, 20, x1, 130, color);
+		} else if (shape < 23) {
+			int r = 8 + ((shape - 18) * 13);
+			mglCircle(190, 68, r, LCD_BLACK, LCD_WHITE);
+			raster_circle(190, 68, r, LCD_BLACK);
+		} else if (shape < 26) {
+			int r = (shape == 23) ? 20 : ((shape == 24) ? 40 : 60);
+			mglCircle(60 + (shape * 4), 68, r, LCD_DARK, LCD_WHITE);
+			raster_circle(60 + (shape * 4), 68, r, LCD_DARK);
+		} else {
+			op_mgl_circles();
+			for (int r = 8; r <= 60; r += 13)
+				raster_circle(190, 68, r, LCD_BLACK);
+			raster_circle(60, 40, 20, LCD_DARK);
+			raster_circle(320, 100, 20, LCD_DARK);
+		}
+		mglFlush();
+		shapes++;
+		differ += raster_compare();
+	}
+
+	printf("%-24s %ld shapes, %ld pixels differ\n", "mgl_pixels", shapes, differ);
+	if (differ)
+		_bench_failures++;
+}
+
+// --------------------------------------------------------------------------------------------
+// every glyph compared with the per-bit expansion of the original lcdPutChar()
+
+// the triplets of one glyph as the original code built them: a pixel at a time with the padding split before and after
+static int glyph_reference(uint8_t *out, const FONTOBJECT *font, char c, uint8_t fg, uint8_t bg) {
+	uint8_t multiplier_width = (font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1;
+	uint8_t multiplier_height = (font->scale & FONT_DOUBLE_HEIGHT) ? 2 : 1;
+	uint8_t glyph_width = font->width * multiplier_width;
+	uint8_t padding = TRIPLET_OFFSET(glyph_width);
+	uint8_t pixels[64];
+	int count = 0;
+
+	for (int r = 0; r < font->height; r++) {
+		const uint8_t *src = &font->data[((c - 32) * font->charbytes) + (r * font->widthbytes)];
+		int n = 0;
+		if (padding == 2)
+			pixels[n++] = bg;
+		for (int k = 0; k < glyph_width; k++) {
+			int bit = k / multiplier_width;
+			pixels[n++] = ((src[bit / 8] >> (bit % 8)) & 1) ? fg : bg;
+		}
+		while (n % TRIPLET_SIZE)
+			pixels[n++] = bg;
+
+		for (int m = 0; m < multiplier_height; m++)
+			for (int i = 0; i < n; i += TRIPLET_SIZE)
+				out[count++] = LCD_CORRECT_COLOR((pixels[i] << 6) | (pixels[i + 1] << 3) | pixels[i + 2]);
+	}
+	return count;
+}
+
+// the 4 default fonts and synthetic fonts 4 to 16 pixels wide, at every scale, for every printable character and fg/bg pair
+static void bench_glyphs() {
+	static const uint8_t widths[] = {4, 5, 6, 7, 8, 9, 10, 12, 16};
+	static uint8_t synthetic[95 * 2 * 8];
+	uint8_t expected[EMU_RAM_WIDTH * 32];
+	FONTOBJECT fonts[FONTS_MAX];
+	long glyphs = 0, differ = 0;
+
+	memcpy(fonts, _srxe_fonts, sizeof(fonts));
+	srand(1);
+	for (unsigned i = 0; i < sizeof(synthetic); i++)
+		synthetic[i] = rand();
+
+	for (unsigned f = 0; f < FONTS_MAX + (sizeof(widths) * 4); f++) {
+		if (f >= FONTS_MAX) {
+			uint8_t width = widths[(f - FONTS_MAX) / 4];
+			uint8_t width_bytes = (width + 7) / 8;
+			lcdFontConfig(FONT1, synthetic, width, 8, width_bytes, width_bytes * 8, (f - FONTS_MAX) % 4);
+		}
+		lcdFontSet((f >= FONTS_MAX) ? (uint8_t)FONT1 : f);
+		FONTOBJECT *font = _lcd_font_get_pointer();
+		uint8_t height = font->height * ((font->scale & FONT_DOUBLE_HEIGHT) ? 2 : 1);
+
+		for (uint8_t fg = 0; fg < 4; fg++) {
+			for (uint8_t bg = 0; bg < 4; bg++) {
+				for (char c = 32; c < 127; c++) {
+					int count = glyph_reference(expected, font, c, fg, bg);
+					int cell = count / height;
+					lcdColorSet(fg, bg);
+					lcdPositionSet(0, 0);
+					lcdPutChar(c);
+					for (int r = 0; r < height; r++) {
+						if (memcmp(_emu_lcd.ram[r], &expected[r * cell], cell)) {
+							differ++;
+							break;
+						}
+					}
+					glyphs++;
+				}
+			}
+		}
+	}
+	memcpy(_srxe_fonts, fonts, sizeof(fonts));
+
+	printf("%-24s %ld glyphs, %ld differ\n", "glyphs", glyphs, differ);
+	if (differ)
+		_bench_failures++;
+}
+
+// --------------------------------------------------------------------------------------------
+// host throughput; the numbers are only meaningful relative to another build on the same host
+
+// the best of several runs, so another program on the host does not skew the result
+static double text_rate(uint8_t font) {
+	const char *text = "The quick brown fox!";
+	const int repeat = 20000;
+	struct timespec t0, t1;
+	double best = 0;
+
+	clear_white();
+	lcdFontSet(font);
+	lcdColorSet(LCD_BLACK, LCD_WHITE);
+	_emu_lcd_decode = false;	// time the drawing code, not the model
+	for (int run = 0; run < 5; run++) {
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (int i = 0; i < repeat; i++)
+			lcdPutStringAt(text, 0, 40);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		double rate = (repeat * strlen(text)) / ((t1.tv_sec - t0.tv_sec) + ((t1.tv_nsec - t0.tv_nsec) / 1e9));
+		if (rate > best)
+			best = rate;
+	}
+	_emu_lcd_decode = true;
+
+	return best;
+}
+
+static void bench_text_speed(const char *name, uint8_t font) {
+	printf("%-24s %10.0f chars/s (host)\n", name, text_rate(font));
+}
+
+// pack a 1-bit font as triplet masks, the same as font_gen.py --triplets; returns the triplets in a row
+static uint8_t triplet_pack(uint8_t *out, const uint8_t *data, uint8_t width, uint8_t height, uint8_t width_bytes) {
+	uint8_t padding = TRIPLET_OFFSET(width);
+	uint8_t cell = TRIPLET_FROM_ACTUAL(width + padding);
+
+	for (int c = 0; c < 95; c++) {
+		for (int r = 0; r < height; r++) {
+			const uint8_t *src = &data[((c * height) + r) * width_bytes];
+			uint8_t pixels[32] = {0};
+			for (int k = 0; k < width; k++)
+				pixels[k + ((padding == 2) ? 1 : 0)] = (src[k / 8] >> (k % 8)) & 1;
+			for (int t = 0; t < cell; t++)
+				*out++ = (pixels[t * 3] ? 0xc0 : 0) | (pixels[(t * 3) + 1] ? 0x18 : 0) | (pixels[(t * 3) + 2] ? 0x03 : 0);
+		}
+	}
+	return cell;
+}
+
+// a 1-bit font and the same font as triplets: the FLASH each needs, the host speed of each, and whether they draw the same
+static void bench_triplets(const char *name, const uint8_t *data, uint8_t width, uint8_t height, uint8_t width_bytes) {
+	static uint8_t triplets[95 * 8 * 32];
+	static uint8_t screen[2][EMU_RAM_HEIGHT][EMU_RAM_WIDTH];
+	FONTOBJECT fonts[FONTS_MAX];
+	long differ = 0;
+
+	memcpy(fonts, _srxe_fonts, sizeof(fonts));
+	uint8_t cell = triplet_pack(triplets, data, width, height, width_bytes);
+
+	for (uint8_t scale = 0; scale <= FONT_DOUBLE_HEIGHT; scale += FONT_DOUBLE_HEIGHT) {
+		lcdFontConfig(FONT3, data, width, height, width_bytes, width_bytes * height, scale);
+		lcdFontConfig(FONT4, triplets, width, height, cell, cell * height, scale | FONT_TRIPLETS);
+		for (uint8_t fg = 0; fg < 4; fg++) {
+			for (uint8_t bg = 0; bg < 4; bg++) {
+				for (int c = 32; c < 127; c += 19) {
+					char text[20];
+					for (int i = 0; i < 19; i++)
+						text[i] = ((c + i) < 127) ? (c + i) : ' ';
+					text[19] = 0;
+					for (int v = 0; v < 2; v++) {
+						lcdFill(0x55);
+						lcdFontSet(v ? FONT4 : FONT3);
+						lcdColorSet(fg, bg);
+						lcdPutStringAt(text, 0, 0);
+						memcpy(screen[v], _emu_lcd.ram, sizeof(screen[v]));
+					}
+					if (memcmp(screen[0], screen[1], sizeof(screen[0])))
+						differ++;
+				}
+			}
+		}
+	}
+
+	lcdFontConfig(FONT3, data, width, height, width_bytes, width_bytes * height, 0);
+	lcdFontConfig(FONT4, triplets, width, height, cell, cell * height, FONT_TRIPLETS);
+	double bits_rate = text_rate(FONT3);
+	double triplets_rate = text_rate(FONT4);
+	memcpy(_srxe_fonts, fonts, sizeof(fonts));
+
+	printf("%-24s %6d / %6d FLASH bytes %10.0f / %10.0f chars/s (host) %.2fx, %ld differ\n", name,
+		   95 * width_bytes * height, 95 * cell * height, bits_rate, triplets_rate, triplets_rate / bits_rate, differ);
+	if (differ)
+		_bench_failures++;
+}
+
+// --------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv) {
+	if (argc > 1)
+		_bench_out = argv[1];
+	if (argc > 2)
+		_bench_golden = argv[2];
+
+	emuLcdReset();
+	emuFlashErase();
+	flashInit();
+	lcdInit();
+
+	mkdir(_bench_out, 0755);
+
+	printf("%-24s %8s %8s %8s %10s\n", "operation", "cmd", "pixels", "windows", "bus(us)");
+
+	bench_run("fill", NULL, op_fill, 1);
+	bench_run("rect_filled", clear_white, op_rect_filled, 1);
+	bench_run("rect_hollow", clear_white, op_rect_hollow, 1);
+	bench_run("rect_erase", clear_white, op_rect_erase, 1);
+	bench_run("lines", clear_white, op_lines, 1);
+	bench_run("grid_table", clear_white, op_grid_table, 1);
+	bench_run("grid_cells", clear_white, op_grid_cells, 1);
+	bench_run("grid_clip", clear_white, op_grid_clip, 1);
+	bench_run("bitmap", clear_white, op_bitmap, 1);
+	bench_run("bitmap_v2", clear_white, op_bitmap_v2, 1);
+	bench_run("bitmap_clip_v1", clear_white, op_bitmap_clip_v1, 1);
+	bench_run("bitmap_clip_v2", clear_white, op_bitmap_clip_v2, 1);
+	bench_run("flash_bitmap", flash_scene, op_flash_bitmap, 1);
+	bench_run("flash_blit", flash_scene, op_flash_blit, 1);
+	bench_run("text_font1", clear_white, op_text_font1, 1);
+	bench_run("text_font2", clear_white, op_text_font2, 1);
+	bench_run("text_font3", clear_white, op_text_font3, 1);
+	bench_run("text_font4", clear_white, op_text_font4, 1);
+	bench_run("text_grey", clear_white, op_text_grey, 1);
+	bench_run("menu_round_end", clear_white, op_menu, 1);
+	bench_run("menu_rounded", clear_white, op_menu_rounded, 1);
+	bench_run("menu_rectangle", clear_white, op_menu_rectangle, 1);
+	bench_run("page_flip", clear_white, op_page_flip, 1);
+	lcdPageFlipEnd();
+	bench_run("console_line", console_full, op_console_line, 1);
+	lcdConsoleEnd();
+	bench_run("shadow_cursor", shadow_scene, op_shadow_cursor, 1);
+	bench_run("mgl_form", clear_white, op_mgl_form, 1);
+	bench_run("mgl_update", NULL, op_mgl_update, 1);
+	bench_run("mgl_delete", NULL, op_mgl_delete, 1);
+	bench_run("mgl_lines", clear_white, op_mgl_lines, 1);
+	bench_run("mgl_circles", clear_white, op_mgl_circles, 1);
+	bench_run("tiles_scroll", tiles_scene, op_tiles_scroll, 1);
+	bench_run("tiles_sprite", tiles_scene, op_tiles_sprite, 1);
+#ifdef LCD_BAND
+	bench_run("band", clear_white, op_band, 1);
+#endif
+
+	bench_glyphs();
+	bench_mgl_pixels();
+
+	bench_text_speed("text_speed_font1", FONT1);
+	bench_text_speed("text_speed_font2", FONT2);
+
+	// the default fonts and a random 12x18 font, as 1-bit and as triplets
+	static uint8_t wide[95 * 2 * 18];
+	for (unsigned i = 0; i < sizeof(wide); i++)
+		wide[i] = rand();
+	bench_triplets("triplets_6x8", font_6X8_P, FONT_6X8_WIDTH, FONT_6X8_HEIGHT, FONT_6X8_WIDTHBYTES);
+	bench_triplets("triplets_8x12", font_8X14_P, FONT_8X14_WIDTH, FONT_8X14_HEIGHT, FONT_8X14_WIDTHBYTES);
+	bench_triplets("triplets_12x18", wide, 12, 18, 2);
+
+	printf("%s\n", _bench_failures ? "FAILED: a screen or a text check differs" : "all screens and text checks match");
+
+	return _bench_failures ? 1 : 0;
+}
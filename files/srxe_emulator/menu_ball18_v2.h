@@ -0,0 +1,51 @@
+
+// GENERATED FILE - DO NOT EDIT
+// To change bitmaps, edit and run python3 bitmap_gen.py
+// generated from RAW bitmap file: "menu_ball18.raw"
+
+// NOTE: Data is a version 2 bitmap; a table of row offsets is followed by run and literal packets for each row.
+//       each byte represents up to 3 pixels - called a TRIPLET - to match the LCD driver of the SRXE.
+
+
+#ifndef __MENU_BALL18_
+#define __MENU_BALL18_
+
+
+// Original file menu_ball18.raw
+
+#include <avr/pgmspace.h>
+
+
+#define MENU_BALL18_WIDTH 18
+#define MENU_BALL18_HEIGHT 18
+
+const uint8_t menu_ball18_v2[] PROGMEM ={
+	0x12, 0x80, // image width=18
+	0x12, 0x00, // image height=18
+	0x00,0x00,0x07,0x00,0x0e,0x00,0x15,0x00,0x1b,0x00,0x21,0x00,0x27,0x00,0x2d,0x00,
+	0x33,0x00,0x39,0x00,0x3f,0x00,0x45,0x00,0x4b,0x00,0x51,0x00,0x57,0x00,0x5d,0x00,
+	0x64,0x00,0x6b,0x00,
+	0x05,0x00,0x00,0x52,0x91,0x00,0x00, // row 0
+	0x05,0x00,0x0b,0xff,0xff,0xe8,0x00, // row 1
+	0x05,0x00,0x9f,0xff,0xff,0xfe,0x00, // row 2
+	0x00,0x02,0x83,0xff,0x00,0x80, // row 3
+	0x00,0x0b,0x83,0xff,0x00,0xe8, // row 4
+	0x00,0x1f,0x83,0xff,0x00,0xfc, // row 5
+	0x00,0x5f,0x83,0xff,0x00,0xfd, // row 6
+	0x00,0x9f,0x83,0xff,0x00,0xfe, // row 7
+	0x00,0x9f,0x83,0xff,0x00,0xfe, // row 8
+	0x00,0x9f,0x83,0xff,0x00,0xfe, // row 9
+	0x00,0x9f,0x83,0xff,0x00,0xfe, // row 10
+	0x00,0x5f,0x83,0xff,0x00,0xfd, // row 11
+	0x00,0x1f,0x83,0xff,0x00,0xfc, // row 12
+	0x00,0x0b,0x83,0xff,0x00,0xe8, // row 13
+	0x00,0x02,0x83,0xff,0x00,0x80, // row 14
+	0x05,0x00,0x9f,0xff,0xff,0xfe,0x00, // row 15
+	0x05,0x00,0x0b,0xff,0xff,0xe8,0x00, // row 16
+	0x05,0x00,0x00,0x52,0x89,0x00,0x00, // row 17
+};
+// Total bytes from original bitmap: 324
+// Total bytes to RLE datafrom original bitmap: 150
+
+#endif // __MENU_BALL18_
+
@@ -0,0 +1,201 @@
+/* ************************************************************************************
+* File:    rf_star_sim.cpp
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+### RF Star Simulator
+
+`rf_star_sim` runs the `rfstar.h` state functions for one base and a room of responders against a simulated radio.
+
+The radio model is a single channel at 250kbps. A frame is lost if any other frame is on the air at the same time
+_(no capture)_, and each frame is also lost with the given probability. Each responder sends its reply up to the given
+jitter early or late. A responder answers in the round after the beacon which told it the question.
+
+Three questions are asked. The first starts with an empty roster, so every responder must join in the contention slots;
+the second is answered by a full roster in the assigned slots. The third starts again with an empty roster and
+responders which only answer once the base has their join, so the joins carry no answer and the answer is sent
+in the round of the beacon which gives the slot. For each question the simulator reports the time until every responder has answered,
+the number of rounds, the frames sent and lost, and the replies sent outside their part of the round
+_(an answer after the assigned slots or a join before the contention slots)_.
+The program exits non-zero if any question takes more than 2 seconds or any reply is misplaced.
+
+### Usage
+
+`./build.sh` then `./rf_star_sim` [_responders_] [_loss-percent_] [_jitter-us_] [_contention_]
+
+|PARAMETER|DESCRIPTION|
+|:-----|:-----|
+|responders|the number of responders (default 100)|
+|loss percent|the chance any frame is lost (default 5)|
+|jitter us|the largest timing error of a responder (default 50)|
+|contention|the contention slots in each round (default 16)|
+
+--------------------------------------------------------------------------
+--- */
+
+#include <stdlib.h>
+
+#include "srxe_emulator.h"
+
+#ifndef RF_STAR
+#define RF_STAR
+#endif
+
+#include "_avr_includes.h"
+#include "_srxe_includes.h"
+
+// printf.h redirects these to its own implementations; the host versions are used here
+#undef printf
+#undef snprintf
+
+typedef struct {
+	int node;					// the responder
+	uint32_t start, end;
+	uint8_t length;
+	uint8_t data[16];
+	bool lost;
+} SIM_TX;
+
+static RFSTAR_BASE _sim_base;
+static RFSTAR_NODE *_sim_nodes;
+static int _sim_count;
+static int _sim_loss;
+static int _sim_jitter;
+static bool _sim_late;			// a responder answers only once the base has its join
+static uint32_t _sim_frames, _sim_collisions, _sim_dropped, _sim_misplaced;
+
+static bool sim_lost() {
+	return (rand() % 100) < _sim_loss;
+}
+
+// run one round; returns its length in microseconds
+static uint32_t sim_round(uint32_t now) {
+	static SIM_TX tx[RF_STAR_SLOTS + 1];
+	int count = 0;
+
+	uint8_t beacon[RF_FRAME_MAX];
+	uint8_t length = rfStarBaseBeacon(&_sim_base, beacon);
+	uint32_t beacon_end = now + _rf_star_air_us(length);
+	uint8_t open = _sim_base.count - rfStarBaseAnswered(&_sim_base);
+	uint32_t round_us = rfStarRoundUs(open, _sim_base.contention);
+	uint32_t contention_us = RF_STAR_GAP_US + (uint32_t)open * RF_STAR_SLOT_US;	// the start of the contention slots
+	_sim_frames++;
+
+	for (int i = 0; i < _sim_count; i++) {
+		RFSTAR_NODE *node = &_sim_nodes[i];
+		if (sim_lost()) {
+			_sim_dropped++;
+			continue;
+		}
+
+		// the responder answers once it has seen the question in an earlier beacon (and once it has joined, if late)
+		if ((node->question == _sim_base.question) && (node->answer == RF_STAR_NONE) &&
+			(!_sim_late || (_rf_star_find(&_sim_base, (const uint8_t *)node->id) != RF_STAR_NONE)))
+			rfStarNodeAnswer(node, 1 + (i % 4));
+
+		SIM_TX *t = &tx[count];
+		uint32_t delay_us;
+		t->length = rfStarNodeBeacon(node, beacon, length, t->data, &delay_us);
+		if (!t->length)
+			continue;
+		if ((t->data[0] == _RF_STAR_ANSWER) ? (delay_us >= contention_us) : (delay_us < contention_us))
+			_sim_misplaced++;
+
+		int jitter = _sim_jitter ? ((rand() % (2 * _sim_jitter + 1)) - _sim_jitter) : 0;
+		t->node = i;
+		t->start = beacon_end + delay_us + jitter;
+		t->end = t->start + _rf_star_air_us(t->length);
+		t->lost = false;
+		count++;
+	}
+
+	// frames which overlap are all lost
+	for (int i = 0; i < count; i++) {
+		for (int j = i + 1; j < count; j++) {
+			if ((tx[i].start < tx[j].end) && (tx[j].start < tx[i].end)) {
+				if (!tx[i].lost) _sim_collisions++;
+				if (!tx[j].lost) _sim_collisions++;
+				tx[i].lost = tx[j].lost = true;
+			}
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		_sim_frames++;
+		if (tx[i].lost)
+			continue;
+		if (sim_lost()) {
+			_sim_dropped++;
+			continue;
+		}
+		rfStarBaseFrame(&_sim_base, tx[i].data, tx[i].length);
+	}
+
+	return (beacon_end - now) + round_us;
+}
+
+// ask a question and run rounds until every responder has answered; returns true if it took too long or a reply was misplaced
+static bool sim_question(const char *name) {
+	uint32_t now = 0;
+	int rounds = 0;
+
+	_sim_frames = _sim_collisions = _sim_dropped = _sim_misplaced = 0;
+	rfStarBaseQuestion(&_sim_base);
+
+	while ((_sim_base.count < _sim_count) || (rfStarBaseAnswered(&_sim_base) < _sim_count)) {
+		now += sim_round(now);
+		rounds++;
+		if (now > 60000000UL)
+			break;
+	}
+
+	printf("%-14s %4d of %4d answered %8.3f s %5d rounds %6u frames %5u collided %5u lost %3u misplaced\n",
+		   name, rfStarBaseAnswered(&_sim_base), _sim_count, now / 1000000.0, rounds,
+		   _sim_frames, _sim_collisions, _sim_dropped, _sim_misplaced);
+	if (now > 2000000UL)
+		printf("FAILED: more than 2 seconds with the %s\n", name);
+	if (_sim_misplaced)
+		printf("FAILED: replies outside their part of the round with the %s\n", name);
+	return (now > 2000000UL) || _sim_misplaced;
+}
+
+int main(int argc, char *argv[]) {
+	_sim_count = (argc > 1) ? atoi(argv[1]) : 100;
+	_sim_loss = (argc > 2) ? atoi(argv[2]) : 5;
+	_sim_jitter = (argc > 3) ? atoi(argv[3]) : 50;
+	int contention = (argc > 4) ? atoi(argv[4]) : 16;
+
+	if ((_sim_count < 1) || (_sim_count > RF_STAR_SLOTS)) {
+		printf("responders must be 1 .. %d\n", RF_STAR_SLOTS);
+		return 1;
+	}
+	srand(1);
+
+	_sim_nodes = (RFSTAR_NODE *)calloc(_sim_count, sizeof(RFSTAR_NODE));
+	printf("%d responders, %d%% loss, %dus jitter, %d contention slots\n", _sim_count, _sim_loss, _sim_jitter, contention);
+
+	bool failed = false;
+	for (int late = 0; late < 2; late++) {
+		// the IDs look like eepromSignature() strings
+		for (int i = 0; i < _sim_count; i++) {
+			char id[RF_STAR_ID_SIZE + 1];
+			snprintf(id, sizeof(id), "%06X", (unsigned)(0x1E0000 + (i * 7919)) & 0xFFFFFF);
+			rfStarNodeInit(&_sim_nodes[i], id);
+		}
+		rfStarBaseInit(&_sim_base, 0x5A, contention);
+		_sim_late = late;
+
+		if (!late) {
+			failed |= sim_question("empty roster");
+			failed |= sim_question("full roster");
+		} else {
+			failed |= sim_question("joins first");
+		}
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,290 @@
+/* ************************************************************************************
+* File:    rf_transfer_sim.cpp
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+### RF Transfer Simulator
+
+`rf_transfer_sim` runs `rftransfer.h` on a few simulated SRXEs which share one radio channel.
+The `rf.h` send and receive functions are replaced by a model of the channel: one frame at a time at 250kbps,
+each frame is heard by every other SRXE, each copy is lost with the given probability,
+and a frame which arrives while all `RF_RX_SLOTS` are full is dropped.
+
+Four cases are run for each window size from 1 to 16:
+
+|CASE|EXPECTED|
+|:-----|:-----|
+|one receiver|the sender and the receiver are done and the message matches|
+|two receivers|the sender is done and the receiver it followed has the whole message|
+|the sender stops|the receiver fails after `RF_TRANSFER_INACTIVE` ms|
+|no receiver|the sender fails after `RF_TRANSFER_RETRIES`|
+
+For each window the simulator reports the time of a 5000 byte message with one receiver, its goodput, and the frames sent.
+The program exits non-zero if any case does not end as expected. With the default `RF_TRANSFER_RETRIES` a transfer
+should finish at up to about 25% loss; above that the sender may give up.
+
+### Usage
+
+`./build.sh` then `./rf_transfer_sim` [_loss-percent_]
+
+|PARAMETER|DESCRIPTION|
+|:-----|:-----|
+|loss percent|the chance any copy of a frame is lost (default 10)|
+
+--------------------------------------------------------------------------
+--- */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// rf.h and clock.h are replaced by the model below
+#define __SRXE_RF_
+#define __SRXE_CLOCK_
+
+#ifndef RF_TRANSFER
+#define RF_TRANSFER
+#endif
+
+#define RF_FRAME_MAX		125
+#define RF_MAC_HEADER		9
+#define RF_BROADCAST		0xFFFF
+#define RF_TX_QUEUE_SIZE	4
+#define RF_RX_SLOTS			4
+
+typedef struct {
+	uint8_t length;
+	uint8_t rssi;
+	uint8_t lqi;
+	uint16_t src;
+	uint32_t time;
+	uint8_t data[RF_FRAME_MAX];
+} RFFRAME;
+
+#define SIM_NODES	3
+#define SIM_FRAMES	(SIM_NODES * RF_TX_QUEUE_SIZE)
+
+typedef struct {
+	int node;
+	uint8_t length;
+	uint8_t data[RF_FRAME_MAX];
+} SIM_TX;
+
+static uint32_t _sim_us;					// the simulated time
+static uint32_t _sim_boot[SIM_NODES];		// when each SRXE was turned on
+static int _sim_node;						// the SRXE which is running
+static int _sim_loss;
+static bool _sim_on[SIM_NODES];				// the SRXE has a transfer to run
+static uint32_t _sim_frames;
+
+static SIM_TX _sim_air[SIM_FRAMES];			// the frames waiting for the channel, oldest first
+static int _sim_air_count;
+static RFFRAME _sim_rx[SIM_NODES][RF_RX_SLOTS];
+static int _sim_rx_tail[SIM_NODES], _sim_rx_count[SIM_NODES];
+
+static bool _rf_ext;
+
+uint32_t clockMillis() {
+	return (_sim_us - _sim_boot[_sim_node]) / 1000;
+}
+
+uint32_t clockMicros() {
+	return _sim_us - _sim_boot[_sim_node];
+}
+
+uint8_t rfInited() {
+	return 1;
+}
+
+static uint8_t _rf_payload_max() {
+	return _rf_ext ? (RF_FRAME_MAX - RF_MAC_HEADER) : RF_FRAME_MAX;
+}
+
+// send the oldest waiting frame to every other SRXE
+static void sim_air() {
+	if (!_sim_air_count)
+		return;
+
+	SIM_TX *t = &_sim_air[0];
+	_sim_us += (6 + t->length + 2) * 32 + 192;		// preamble and PHY header, CRC, the turnaround of the receiver
+	_sim_frames++;
+	for (int i = 0; i < SIM_NODES; i++) {
+		if ((i == t->node) || ((rand() % 100) < _sim_loss) || (_sim_rx_count[i] >= RF_RX_SLOTS))
+			continue;
+		RFFRAME *frame = &_sim_rx[i][(_sim_rx_tail[i] + _sim_rx_count[i]) % RF_RX_SLOTS];
+		frame->length = t->length;
+		frame->src = RF_BROADCAST;
+		frame->time = _sim_us - _sim_boot[i];
+		memcpy(frame->data, t->data, t->length);
+		_sim_rx_count[i]++;
+	}
+	memmove(&_sim_air[0], &_sim_air[1], (_sim_air_count - 1) * sizeof(SIM_TX));
+	_sim_air_count--;
+}
+
+uint8_t rfSendQueued() {
+	int count = 0;
+	for (int i = 0; i < _sim_air_count; i++)
+		if (_sim_air[i].node == _sim_node)
+			count++;
+	return count;
+}
+
+int rfSendFrame(const uint8_t *data, uint8_t len) {
+	// the caller waits for room in the TX queue; the channel runs meanwhile
+	if (rfSendQueued() >= RF_TX_QUEUE_SIZE) {
+		sim_air();
+		return -1;
+	}
+	SIM_TX *t = &_sim_air[_sim_air_count++];
+	t->node = _sim_node;
+	t->length = len;
+	memcpy(t->data, data, len);
+	return len;
+}
+
+int rfSendTo(uint16_t address, const uint8_t *data, uint8_t len) {
+	(void)address;
+	return rfSendFrame(data, len);
+}
+
+RFFRAME *rfRecvFrame() {
+	if (!_sim_rx_count[_sim_node])
+		return NULL;
+	return &_sim_rx[_sim_node][_sim_rx_tail[_sim_node]];
+}
+
+void rfReleaseFrame() {
+	if (_sim_rx_count[_sim_node]) {
+		_sim_rx_tail[_sim_node] = (_sim_rx_tail[_sim_node] + 1) % RF_RX_SLOTS;
+		_sim_rx_count[_sim_node]--;
+	}
+}
+
+#include "rftransfer.h"
+
+#define SIM_LENGTH	5000
+#define SIM_LIMIT	20000000UL				// 20 seconds
+
+static _RF_TRANSFER _sim_xfer[SIM_NODES];
+static uint8_t _sim_state[SIM_NODES];
+static uint8_t _sim_message[SIM_LENGTH];
+static uint8_t _sim_buffer[SIM_NODES][SIM_LENGTH + 100];
+
+static void sim_reset() {
+	memset(_sim_xfer, 0, sizeof(_sim_xfer));
+	memset(_sim_state, 0, sizeof(_sim_state));
+	memset(_sim_buffer, 0, sizeof(_sim_buffer));
+	memset(_sim_rx_count, 0, sizeof(_sim_rx_count));
+	memset(_sim_on, 0, sizeof(_sim_on));
+	memset(&_rf_xfer, 0, sizeof(_rf_xfer));
+	_sim_node = 0;
+	_sim_air_count = 0;
+	_sim_frames = 0;
+	_sim_us = 1000000UL;
+	for (int i = 0; i < SIM_NODES; i++)
+		_sim_boot[i] = rand() % 1000000UL;
+}
+
+// make `node` the running SRXE
+static void sim_switch(int node) {
+	_sim_xfer[_sim_node] = _rf_xfer;
+	_sim_node = node;
+	_rf_xfer = _sim_xfer[node];
+}
+
+// SRXE 0 sends to `receivers` others; runs until every SRXE which is on has finished
+static uint32_t sim_run(int receivers, uint8_t window, bool vanish) {
+	sim_reset();
+
+	for (int i = 1; i <= receivers; i++) {
+		sim_switch(i);
+		rfTransferReceive(_sim_buffer[i], sizeof(_sim_buffer[i]));
+		_sim_on[i] = true;
+	}
+	sim_switch(0);
+	rfTransferWindow(window);
+	rfTransferSend(RF_BROADCAST, _sim_message, SIM_LENGTH);
+	_sim_on[0] = true;
+	uint32_t start = _sim_us;
+
+	while ((_sim_us - start) < SIM_LIMIT) {
+		bool busy = false;
+		for (int i = 0; i < SIM_NODES; i++) {
+			if (!_sim_on[i])
+				continue;
+			sim_switch(i);
+			_sim_state[i] = rfTransferPoll();
+			if (_sim_state[i] == RF_TRANSFER_BUSY)
+				busy = true;
+		}
+		// the sender is turned off part way through the message
+		if (vanish && _sim_on[0] && (_sim_xfer[0].next > (_sim_xfer[0].count / 2))) {
+			int count = 0;
+			for (int i = 0; i < _sim_air_count; i++)
+				if (_sim_air[i].node != 0)
+					_sim_air[count++] = _sim_air[i];
+			_sim_air_count = count;
+			_sim_on[0] = false;
+		}
+		if (!busy)
+			break;
+		if (_sim_air_count)
+			sim_air();
+		else
+			_sim_us += 100;
+	}
+	sim_switch(0);
+	return _sim_us - start;
+}
+
+static bool sim_match(int node) {
+	return (_sim_xfer[node].length == SIM_LENGTH) && !memcmp(_sim_buffer[node], _sim_message, SIM_LENGTH);
+}
+
+static bool sim_check(bool ok, const char *what, uint8_t window) {
+	if (!ok)
+		printf("FAILED: %s with a window of %d\n", what, window);
+	return ok;
+}
+
+int main(int argc, char *argv[]) {
+	_sim_loss = (argc > 1) ? atoi(argv[1]) : 10;
+	bool ok = true;
+
+	srand(1);
+	for (int i = 0; i < SIM_LENGTH; i++)
+		_sim_message[i] = rand();
+
+	printf("%d byte message, %d%% loss\n", SIM_LENGTH, _sim_loss);
+	for (uint8_t window = 1; window <= 16; window *= 2) {
+		uint32_t us = sim_run(1, window, false);
+		printf("window %2d: %8.3f s %6u B/s %5u frames\n", window, us / 1000000.0,
+			   (unsigned)((uint64_t)SIM_LENGTH * 1000000UL / us), _sim_frames);
+		ok &= sim_check((_sim_state[0] == RF_TRANSFER_DONE) && (_sim_state[1] == RF_TRANSFER_DONE) && sim_match(1),
+						"one receiver", window);
+
+		// the sender follows one receiver, which must have the whole message
+		sim_run(2, window, false);
+		int followed = (_sim_xfer[0].tag == _sim_xfer[1].tag) ? 1 : 2;
+		ok &= sim_check((_sim_xfer[0].tag != 0) && (_sim_xfer[1].tag != _sim_xfer[2].tag), "two receivers have one tag", window);
+		ok &= sim_check((_sim_state[0] == RF_TRANSFER_DONE) && (_sim_state[followed] == RF_TRANSFER_DONE) && sim_match(followed),
+						"two receivers", window);
+
+		us = sim_run(1, window, true);
+		ok &= sim_check((_sim_state[1] == RF_TRANSFER_FAILED) && (us < SIM_LIMIT), "the sender stops", window);
+
+		sim_run(0, window, false);
+		ok &= sim_check(_sim_state[0] == RF_TRANSFER_FAILED, "no receiver", window);
+	}
+
+	printf(ok ? "all transfers ended as expected\n" : "FAILED: a transfer did not end as expected\n");
+	return ok ? 0 : 1;
+}
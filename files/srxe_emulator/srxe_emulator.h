@@ -0,0 +1,342 @@
+/* ************************************************************************************
+* File:    srxe_emulator.h
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+# SMART Response XE LCD Emulator
+
+The emulator is a host (Linux) build of the SRXEcore LCD code with the SPI bus and the LCD controller replaced
+by a software model. It is used to measure and regression test the LCD drawing code without hardware.
+
+The `avr/` and `util/` folders are host replacements for the AVR headers.
+The I/O registers are ordinary variables except `SPDR` and `SPSR`.
+A write to `SPDR` is one byte on the emulated bus. The model samples `LCD_CS` and `LCD_DC` from the port
+registers - exactly as the controller samples the pins - so `_srxe_spi_transfer()`, the block transfers,
+and `srxeDigitalWrite()` run unmodified. PROGMEM is ordinary memory.
+
+The controller model decodes the commands used by `_lcd_power_up_commands` and the drawing code:
+the `0x2a`/`0x2b` column and row window, `0x2c` memory write, `0x33` scroll area, `0x37` scroll start line,
+and `0x01` soft reset. The display RAM is the full 384x160 with 2 bits per pixel.
+
+The model counts command bytes, data bytes, pixel bytes _(data written to the display RAM)_, and windows (`0x2c` commands).
+
+The FLASH chip is modelled for the `0x03` read command only; its contents are loaded with `emuFlashLoad()`.
+The model samples `FLASH_CS` at each byte, so a command starts with the first byte after `FLASH_CS` was seen high.
+Bytes read from the FLASH are counted separately.
+
+The _bus time_ assumes the SRXE SPI clock of F_CPU/2 (8MHz) so each byte is 1 microsecond.
+It does not include CPU time between bytes.
+
+When the code under test enables the SPI interrupt _(`LCD_ASYNC_QUEUE`)_, the emulator runs `SPI_STC_vect` after each byte.
+
+Build with `build.sh` _(g++ is required)_; extra compiler flags may follow the source folder, eg: `./build.sh ../../src -DLCD_ASYNC_QUEUE`.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_EMULATOR_
+#define __SRXE_EMULATOR_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "avr/io.h"
+
+#define EMU_RAM_WIDTH		128		// triplets
+#define EMU_RAM_HEIGHT		160		// driver lines
+#define EMU_VISIBLE_HEIGHT	136
+#define EMU_SPI_BYTE_NS		1000	// 8 bits at 8MHz
+
+typedef struct {
+	uint32_t command_bytes;
+	uint32_t data_bytes;
+	uint32_t pixel_bytes;			// data bytes written to display RAM
+	uint32_t windows;				// memory write (0x2c) commands
+	uint32_t deselected_bytes;		// bytes on the bus while LCD_CS is high
+	uint32_t flash_bytes;			// bytes on the bus while FLASH_CS is low
+} EMU_COUNTERS;
+
+typedef struct {
+	uint8_t ram[EMU_RAM_HEIGHT][EMU_RAM_WIDTH];
+
+	uint8_t command;
+	uint8_t params[8];
+	uint8_t param_count;
+
+	uint8_t col_start, col_end, row_start, row_end;
+	uint8_t col, row;
+	bool writing;
+
+	uint8_t scroll_top, scroll_area, scroll_bottom, scroll_start;
+
+	EMU_COUNTERS counters;
+} EMU_LCD;
+
+static EMU_LCD _emu_lcd;
+
+#define EMU_FLASH_SIZE		(128L * 1024)
+
+typedef struct {
+	uint8_t data[EMU_FLASH_SIZE];
+	bool selected;					// FLASH_CS was low at the previous byte
+	uint8_t command;
+	uint8_t count;					// bytes of the current command
+	uint32_t addr;
+} EMU_FLASH;
+
+static EMU_FLASH _emu_flash;
+
+// --------------------------------------------------------------------------------------------
+// registers
+
+#define _EMU_REG_DEFINE(n) volatile uint8_t n;
+_EMU_REG_DEFINE(PINB) _EMU_REG_DEFINE(PIND) _EMU_REG_DEFINE(PINE) _EMU_REG_DEFINE(PINF) _EMU_REG_DEFINE(PING)
+_EMU_REG_DEFINE(PORTB) _EMU_REG_DEFINE(PORTD) _EMU_REG_DEFINE(PORTE) _EMU_REG_DEFINE(PORTF) _EMU_REG_DEFINE(PORTG)
+_EMU_REG_DEFINE(DDRB) _EMU_REG_DEFINE(DDRD) _EMU_REG_DEFINE(DDRE) _EMU_REG_DEFINE(DDRF) _EMU_REG_DEFINE(DDRG)
+_EMU_REG_DEFINE(SPCR) _EMU_REG_DEFINE(SREG)
+_EMU_REG_DEFINE(TCCR0A) _EMU_REG_DEFINE(TCCR0B) _EMU_REG_DEFINE(TCCR2A) _EMU_REG_DEFINE(TCCR2B) _EMU_REG_DEFINE(TCNT0) _EMU_REG_DEFINE(TCNT2)
+_EMU_REG_DEFINE(TIMSK0) _EMU_REG_DEFINE(TIMSK2) _EMU_REG_DEFINE(TIFR2) _EMU_REG_DEFINE(OCR0A) _EMU_REG_DEFINE(OCR2A)
+_EMU_REG_DEFINE(TCCR4A) _EMU_REG_DEFINE(TCCR4B) _EMU_REG_DEFINE(TIMSK4) _EMU_REG_DEFINE(TIFR4)
+volatile uint16_t TCNT4;
+volatile uint16_t OCR4A;
+_EMU_REG_DEFINE(ADCH) _EMU_REG_DEFINE(ADCL) _EMU_REG_DEFINE(ADCSRA) _EMU_REG_DEFINE(ADCSRB) _EMU_REG_DEFINE(ADCSRC) _EMU_REG_DEFINE(ADMUX)
+_EMU_REG_DEFINE(EEAR) _EMU_REG_DEFINE(EECR) _EMU_REG_DEFINE(EEDR)
+_EMU_REG_DEFINE(EICRA) _EMU_REG_DEFINE(EIFR) _EMU_REG_DEFINE(EIMSK)
+_EMU_REG_DEFINE(TRXPR) _EMU_REG_DEFINE(TRX_STATE) _EMU_REG_DEFINE(TRX_STATUS) _EMU_REG_DEFINE(TRX_CTRL_1) _EMU_REG_DEFINE(IRQ_MASK)
+_EMU_REG_DEFINE(PHY_CC_CCA) _EMU_REG_DEFINE(PHY_RSSI) _EMU_REG_DEFINE(PHY_TX_PWR) _EMU_REG_DEFINE(TST_RX_LENGTH)
+_EMU_REG_DEFINE(IRQ_STATUS) _EMU_REG_DEFINE(PAN_ID_0) _EMU_REG_DEFINE(PAN_ID_1) _EMU_REG_DEFINE(SHORT_ADDR_0) _EMU_REG_DEFINE(SHORT_ADDR_1) _EMU_REG_DEFINE(XAH_CTRL_0) _EMU_REG_DEFINE(CSMA_SEED_0)
+
+volatile uint8_t _emu_trx_frame_buffer[129];
+_emu_spdr_reg SPDR;
+_emu_spsr_reg SPSR;
+
+// --------------------------------------------------------------------------------------------
+// controller model
+
+#define _EMU_LCD_SELECTED()	(!(PORTE & (1 << 7)))	// LCD_CS is PE7 and active low
+#define _EMU_LCD_DATA()		(PORTD & (1 << 6))		// LCD_DC is PD6 and high for data
+
+void emuLcdReset() {
+	memset(&_emu_lcd, 0, sizeof(_emu_lcd));
+	_emu_lcd.col_end = EMU_RAM_WIDTH - 1;
+	_emu_lcd.row_end = EMU_RAM_HEIGHT - 1;
+	_emu_lcd.scroll_area = EMU_RAM_HEIGHT;
+}
+
+static void _emu_lcd_command(uint8_t c) {
+	_emu_lcd.counters.command_bytes++;
+	_emu_lcd.command = c;
+	_emu_lcd.param_count = 0;
+	_emu_lcd.writing = false;
+
+	switch (c) {
+		case 0x01: { // soft reset
+			EMU_COUNTERS saved = _emu_lcd.counters;
+			emuLcdReset();
+			_emu_lcd.counters = saved;
+		} break;
+		case 0x2c: // memory write starts at the top left of the window
+			_emu_lcd.col = _emu_lcd.col_start;
+			_emu_lcd.row = _emu_lcd.row_start;
+			_emu_lcd.writing = true;
+			_emu_lcd.counters.windows++;
+			break;
+	}
+}
+
+static void _emu_lcd_data(uint8_t b) {
+	_emu_lcd.counters.data_bytes++;
+
+	if (_emu_lcd.writing) {
+		_emu_lcd.counters.pixel_bytes++;
+		if ((_emu_lcd.row < EMU_RAM_HEIGHT) && (_emu_lcd.col < EMU_RAM_WIDTH))
+			_emu_lcd.ram[_emu_lcd.row][_emu_lcd.col] = b;
+		// the write pointer wraps within the window
+		if (_emu_lcd.col >= _emu_lcd.col_end) {
+			_emu_lcd.col = _emu_lcd.col_start;
+			if (_emu_lcd.row >= _emu_lcd.row_end)
+				_emu_lcd.row = _emu_lcd.row_start;
+			else
+				_emu_lcd.row++;
+		} else {
+			_emu_lcd.col++;
+		}
+		return;
+	}
+
+	if (_emu_lcd.param_count < sizeof(_emu_lcd.params))
+		_emu_lcd.params[_emu_lcd.param_count] = b;
+	_emu_lcd.param_count++;
+
+	uint8_t *p = _emu_lcd.params;
+	switch (_emu_lcd.command) {
+		case 0x2a:
+			if (_emu_lcd.param_count == 4) {
+				_emu_lcd.col_start = p[1];
+				_emu_lcd.col_end = p[3];
+			}
+			break;
+		case 0x2b:
+			if (_emu_lcd.param_count == 4) {
+				_emu_lcd.row_start = p[1];
+				_emu_lcd.row_end = p[3];
+			}
+			break;
+		case 0x33:
+			if (_emu_lcd.param_count == 3) {
+				_emu_lcd.scroll_top = p[0];
+				_emu_lcd.scroll_area = p[1];
+				_emu_lcd.scroll_bottom = p[2];
+			}
+			break;
+		case 0x37:
+			if (_emu_lcd.param_count == 1)
+				_emu_lcd.scroll_start = p[0];
+			break;
+	}
+}
+
+// --------------------------------------------------------------------------------------------
+// FLASH model
+
+#define _EMU_FLASH_SELECTED()	(!(PORTD & (1 << 3)))	// FLASH_CS is PD3 and active low
+
+// copy data into the FLASH; an erased FLASH reads as 0xFF
+void emuFlashLoad(uint32_t addr, const uint8_t *data, uint32_t len) {
+	for (uint32_t i = 0; i < len; i++)
+		_emu_flash.data[(addr + i) % EMU_FLASH_SIZE] = data[i];
+}
+
+void emuFlashErase() {
+	memset(_emu_flash.data, 0xff, sizeof(_emu_flash.data));
+}
+
+// returns the byte the FLASH shifts out in reply to `b`
+static uint8_t _emu_flash_byte(uint8_t b) {
+	_emu_lcd.counters.flash_bytes++;
+	if (!_emu_flash.selected) {
+		_emu_flash.selected = true;
+		_emu_flash.command = b;
+		_emu_flash.count = 1;
+		_emu_flash.addr = 0;
+		return 0xff;
+	}
+	if (_emu_flash.command != 0x03)
+		return 0xff;
+	if (_emu_flash.count < 4) {
+		_emu_flash.addr = (_emu_flash.addr << 8) | b;	// 3 address bytes, big-endian
+		_emu_flash.count++;
+		return 0xff;
+	}
+	return _emu_flash.data[_emu_flash.addr++ % EMU_FLASH_SIZE];
+}
+
+// the SPI transfer complete interrupt; only present when the code under test uses it (eg: LCD_ASYNC_QUEUE)
+void SPI_STC_vect(void) __attribute__((weak));
+
+static bool _emu_spi_in_isr;
+
+// when false, bytes are not decoded; used to time the drawing code without the cost of the model
+static bool _emu_lcd_decode = true;
+
+_emu_spdr_reg &_emu_spdr_reg::operator=(uint8_t b) {
+	value = b;
+	if (_EMU_FLASH_SELECTED())
+		value = _emu_flash_byte(b);
+	else
+		_emu_flash.selected = false;
+
+	if (!_emu_lcd_decode)
+		;
+	else if (!_EMU_LCD_SELECTED())
+		_emu_lcd.counters.deselected_bytes++;
+	else if (_EMU_LCD_DATA())
+		_emu_lcd_data(b);
+	else
+		_emu_lcd_command(b);
+
+	// a byte completes instantly; with SPIE set the interrupt runs for each byte
+	// the interrupt writes SPDR itself so it is run from a loop here rather than recursively
+	if (SPI_STC_vect && !_emu_spi_in_isr) {
+		_emu_spi_in_isr = true;
+		while (SPCR & (1 << SPIE))
+			SPI_STC_vect();
+		_emu_spi_in_isr = false;
+	}
+	return *this;
+}
+
+// --------------------------------------------------------------------------------------------
+// inspection
+
+// the display RAM line shown on a visible row, after the scroll area has been applied
+uint8_t emuLcdRowSource(uint8_t r) {
+	uint8_t ta = _emu_lcd.scroll_top, sa = _emu_lcd.scroll_area;
+	if (sa && (r >= ta) && (r < ta + sa)) {
+		int offset = ((int)_emu_lcd.scroll_start - ta) + (r - ta);
+		offset %= sa;
+		if (offset < 0)
+			offset += sa;
+		return ta + offset;
+	}
+	return r;
+}
+
+// pixel color (0=white .. 3=black) as it appears on the visible screen; x is in real pixels
+uint8_t emuLcdPixel(int x, int y) {
+	uint8_t b = _emu_lcd.ram[emuLcdRowSource(y)][x / 3];
+	switch (x % 3) {
+		case 0:		return (b >> 6) & 0x3;
+		case 1:		return (b >> 3) & 0x3;
+		default:	return b & 0x3;
+	}
+}
+
+EMU_COUNTERS emuLcdCounters() {
+	return _emu_lcd.counters;
+}
+
+void emuLcdCountersReset() {
+	memset(&_emu_lcd.counters, 0, sizeof(EMU_COUNTERS));
+}
+
+// write the visible screen as a binary PGM (384x136, 4 grey levels)
+bool emuLcdSavePGM(const char *filename) {
+	FILE *f = fopen(filename, "wb");
+	if (!f)
+		return false;
+	fprintf(f, "P5\n%d %d\n255\n", EMU_RAM_WIDTH * 3, EMU_VISIBLE_HEIGHT);
+	for (int y = 0; y < EMU_VISIBLE_HEIGHT; y++)
+		for (int x = 0; x < EMU_RAM_WIDTH * 3; x++)
+			fputc(255 - (emuLcdPixel(x, y) * 85), f);
+	fclose(f);
+	return true;
+}
+
+// compare the visible screen with a PGM written by emuLcdSavePGM(); returns the number of differing pixels or -1 on error
+long emuLcdComparePGM(const char *filename) {
+	FILE *f = fopen(filename, "rb");
+	if (!f)
+		return -1;
+	int w, h, max;
+	if ((fscanf(f, "P5 %d %d %d", &w, &h, &max) != 3) || (w != EMU_RAM_WIDTH * 3) || (h != EMU_VISIBLE_HEIGHT)) {
+		fclose(f);
+		return -1;
+	}
+	fgetc(f);
+	long diffs = 0;
+	for (int y = 0; y < h; y++)
+		for (int x = 0; x < w; x++)
+			if (fgetc(f) != (255 - (emuLcdPixel(x, y) * 85)))
+				diffs++;
+	fclose(f);
+	return diffs;
+}
+
+#endif // __SRXE_EMULATOR_
@@ -0,0 +1,4 @@
+// host replacement for <util/atomic.h>
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 0
+#define ATOMIC_BLOCK(type) for (int _emu_atomic = 1; _emu_atomic; _emu_atomic = 0)
@@ -0,0 +1,4 @@
+// host replacement for <util/delay.h>
+// time does not pass on the emulated bus so delays are ignored
+#define _delay_ms(ms) ((void)0)
+#define _delay_us(us) ((void)0)
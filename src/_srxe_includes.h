@@ -62,10 +62,16 @@ The following order of SRXE functions is recommended:
 #include "eeprom.h"     // access to EEPROM storage
 #include "flash.h"      // access to the tiny 128KB FLASH chip
 #include "rf.h"         // RF Transceiver I/O
+#include "rftransfer.h" // (optional) messages larger than a frame; requires RF_TRANSFER
+#include "rfstar.h"     // (optional) a base collecting answers from a room of responders; requires RF_STAR
 #include "random.h"     // pseudo random number generator (must be after RF)
 #include "lcdbase.h"    // the supporting functions for the remaining LCD functions
 #include "lcddraw.h"    // the basic draw primatives
 #include "lcdtext.h"    // text output to the LCD
+#include "lcdconsole.h" // (optional) scrolling text console on the LCD
+#include "lcdshadow.h"  // (optional) monochrome shadow buffer; requires LCD_SHADOW
+#include "lcdband.h"    // (optional) display list and band renderer for overlapping shapes; requires LCD_BAND
+#include "lcdtiles.h"   // (optional) tile maps and sprites which only send changed cells; requires LCD_TILES
 #include "keyboard.h"   // Keyboard scanning
 #include "ui.h"      	// composite UI elements (requires LCD and keyboard)
 
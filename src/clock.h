@@ -107,6 +107,38 @@ uint32_t clockMillis() {
 }
 
 
+/* ---
+#### uint32_t clockMicros()
+
+Return the time in microseconds as a 32bit unsigned integer. The counter starts at 0 when clockInit() is first called
+and wraps after about 71 minutes.
+
+The resolution comes from the TIMER2 count; at 16Mhz it is 0.5 microseconds.
+--- */
+
+uint32_t clockMicros() {
+	uint32_t ms;
+	uint8_t ticks, count, sreg;
+
+	sreg = SREG;
+	cli();
+	ms = _clock_ms;
+	ticks = _clock_ticks;
+	count = TCNT2;
+	// the timer may have reached the compare value since interrupts were disabled
+	if ((TIFR2 & (1 << OCF2A)) && (count < (OCR2A / 2)))
+		ticks++;
+	SREG = sreg;
+
+#if (F_CPU == 16000000UL) && (TIMER_FREQ == 10000)
+	uint16_t us = count >> 1;	// 8 prescaler = 2 counts per microsecond
+#else
+	uint16_t us = ((uint16_t)count * (1000000UL / TIMER_FREQ)) / (OCR2A + 1);
+#endif
+	return (ms * 1000) + ((uint16_t)ticks * (1000000UL / TIMER_FREQ)) + us;
+}
+
+
 /* ---
 #### void clockDelay(uint32_t duration)
 
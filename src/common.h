@@ -198,6 +198,65 @@ long srxeMap(long val, long in_min, long in_max, long out_min, long out_max) {
 
 
 
+/* ---
+### PROFILING
+
+When `SRXE_PROFILE` is defined, cheap counters are kept for the SPI and LCD hot paths.
+They make it possible to measure the paint cost of a real screen on the device.
+
+|COUNTER|DESCRIPTION|
+|:-----|:-----|
+|spi_bytes|bytes sent on the SPI by the CPU (LCD and FLASH); bytes sent by the `LCD_ASYNC_QUEUE` interrupt are not counted|
+|lcd_commands|LCD command bytes|
+|lcd_data_bytes|LCD data bytes (command parameters and pixels)|
+|lcd_windows|LCD windows opened|
+|lcd_us|microseconds spent in the LCD write functions|
+
+The timing uses `clockMicros()` so `clock.h` must be included and `clockInit()` called.
+Use `printProfile()` to output the counters.
+--- */
+
+#ifdef SRXE_PROFILE
+typedef struct {
+	uint32_t spi_bytes;
+	uint32_t lcd_commands;
+	uint32_t lcd_data_bytes;
+	uint32_t lcd_windows;
+	uint32_t lcd_us;
+} SRXEPROFILE;
+
+SRXEPROFILE _srxe_profile;
+
+#define SRXE_PROFILE_COUNT(field, n)	(_srxe_profile.field += (n))
+
+/* ---
+#### void srxeProfileSnapshot(SRXEPROFILE *copy)
+
+Copy the current profile counters _(only available when `SRXE_PROFILE` is defined)_.
+--- */
+void srxeProfileSnapshot(SRXEPROFILE *copy) {
+	uint8_t sreg = SREG;
+	cli();
+	memcpy(copy, &_srxe_profile, sizeof(SRXEPROFILE));
+	SREG = sreg;
+}
+
+/* ---
+#### void srxeProfileReset()
+
+Clear the profile counters _(only available when `SRXE_PROFILE` is defined)_.
+--- */
+void srxeProfileReset() {
+	uint8_t sreg = SREG;
+	cli();
+	memset(&_srxe_profile, 0, sizeof(SRXEPROFILE));
+	SREG = sreg;
+}
+#else
+#define SRXE_PROFILE_COUNT(field, n)	((void) 0)
+#endif
+
+
 /*
 
 ### COMMON SPI HANDLING
@@ -223,10 +282,30 @@ after the SPI operation(s) have been performed, the `SS` is pulled `HIGH` again
 #define FLASH_CS 	(SRXE_PORTD | PIN3)
 #define FLASH_DC 	(SRXE_PORTD | PIN6)
 
+/*
+void _srxe_spi_wait() - wait until no background (interrupt driven) transfer is using the SPI
+
+When `LCD_ASYNC_QUEUE` is defined, the LCD transmit queue (see lcdbase.h) owns the SPI while it is busy.
+Any other SPI user (eg: the FLASH functions) must call this before selecting its device.
+Without `LCD_ASYNC_QUEUE` this is a no-op.
+*/
+#ifdef LCD_ASYNC_QUEUE
+volatile uint8_t _srxe_spi_busy;	// set while the SPI interrupt is driving a transfer
+
+void _srxe_spi_wait(void) {
+	while (_srxe_spi_busy) {
+	}
+}
+#else
+#define _srxe_spi_wait() ((void) 0)
+#endif
+
 /*
 void _srxe_spi_init() - initialize SPI using direct register access
 */
 void _srxe_spi_init(void) {
+	_srxe_spi_wait();	// do not reconfigure the SPI under an active background transfer
+
 	// Initialize SPI
 
 	srxeDigitalWrite(SPI_CS, HIGH);
@@ -260,6 +339,7 @@ uint8_t _srxe_spi_transfer(volatile uint8_t data) - transfer one byte to the act
 Returns the response byte from the SPI device.
 */
 uint8_t _srxe_spi_transfer(volatile uint8_t data) {
+	SRXE_PROFILE_COUNT(spi_bytes, 1);
 	SPDR = data; // Start the transmission
 
 	/*
@@ -278,5 +358,102 @@ uint8_t _srxe_spi_transfer(volatile uint8_t data) {
 } /* _srxe_spi_transfer() */
 
 
+/*
+void _srxe_spi_write_block(const uint8_t *data, uint16_t len) - write a block of bytes to the active/selected SPI device
+
+This is a write-only transfer. Nothing is read back from the SPI device.
+
+The AVR SPI has no transmit buffer so the next byte can not be written to `SPDR` while the current byte is shifting.
+Instead, the next byte is fetched from memory while the current byte is shifting and it is written the moment `SPIF` is set.
+This keeps the shift register busy with only a cycle or two of idle bus between bytes.
+The loop is unrolled by two to take the loop counter out of the critical path.
+
+Reading `SPSR` (with `SPIF` set) followed by the write to `SPDR` clears `SPIF` so no `SPDR` read is needed per byte.
+*/
+void _srxe_spi_write_block(const uint8_t *data, uint16_t len) {
+	uint8_t next;
+
+	if (!len)
+		return;
+
+	SRXE_PROFILE_COUNT(spi_bytes, len);
+	SPDR = *data++; // start the first byte
+	len--;
+
+	while (len >= 2) {
+		next = *data++; // fetch while the previous byte is shifting
+		while (!(SPSR & (1 << SPIF))) {
+		}
+		SPDR = next;
+
+		next = *data++;
+		while (!(SPSR & (1 << SPIF))) {
+		}
+		SPDR = next;
+		len -= 2;
+	}
+	if (len) {
+		next = *data;
+		while (!(SPSR & (1 << SPIF))) {
+		}
+		SPDR = next;
+	}
+
+	while (!(SPSR & (1 << SPIF))) { // wait for the last byte to finish before the caller releases the CS
+	}
+	(void)SPDR; // leave SPIF clear for the next user of the SPI
+} /* _srxe_spi_write_block() */
+
+
+/*
+void _srxe_spi_write_repeat(uint8_t value, uint16_t count) - write the same byte `count` times to the active/selected SPI device
+
+This is a write-only transfer which streams a constant without using any RAM.
+The count may be as large as the entire LCD (17,408 bytes).
+*/
+void _srxe_spi_write_repeat(uint8_t value, uint16_t count) {
+	if (!count)
+		return;
+
+	SRXE_PROFILE_COUNT(spi_bytes, count);
+	SPDR = value;
+	while (--count) {
+		while (!(SPSR & (1 << SPIF))) {
+		}
+		SPDR = value;
+	}
+
+	while (!(SPSR & (1 << SPIF))) {
+	}
+	(void)SPDR;
+} /* _srxe_spi_write_repeat() */
+
+
+/*
+void _srxe_spi_read_block(uint8_t *data, uint16_t len) - read a block of bytes from the active/selected SPI device
+
+A zero is sent for each byte. The next transfer is started the moment a byte arrives and the byte is stored
+while the next one is shifting, so only the `SPDR` read and write are between the bytes.
+*/
+void _srxe_spi_read_block(uint8_t *data, uint16_t len) {
+	if (!len)
+		return;
+
+	SRXE_PROFILE_COUNT(spi_bytes, len);
+	SPDR = 0; // start the first byte
+	while (--len) {
+		while (!(SPSR & (1 << SPIF))) {
+		}
+		uint8_t b = SPDR;
+		SPDR = 0; // start the next byte before storing this one
+		*data++ = b;
+	}
+
+	while (!(SPSR & (1 << SPIF))) {
+	}
+	*data = SPDR;
+} /* _srxe_spi_read_block() */
+
+
 #endif // __SRXE_COMMON_
 
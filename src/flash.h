@@ -74,6 +74,7 @@ bool flashEraseSector(uint32_t addr, int wait) {
 	uint8_t rc;
 	int timeout;
 
+	_srxe_spi_wait();	// the LCD may still be using the SPI
 	srxeDigitalWrite(FLASH_CS, LOW);
 	_srxe_spi_transfer(0x05); // read status register
 	rc = _srxe_spi_transfer(0);
@@ -131,6 +132,7 @@ bool flashWritePage(uint32_t addr, uint8_t *data) {
 	int i, timeout;
 	uint8_t rc;
 
+	_srxe_spi_wait();	// the LCD may still be using the SPI
 	srxeDigitalWrite(FLASH_CS, LOW);
 	_srxe_spi_transfer(0x05); // read status register
 	rc = _srxe_spi_transfer(0);
@@ -182,19 +184,19 @@ bool flashWritePage(uint32_t addr, uint8_t *data) {
 #### int flashWritePage(uint32_t addr, uint8_t* buffer, uint16_t count)
 
 Read `count` bytes of data from FLASH.
+
+The data is read as one block; the next byte is shifting while the previous one is stored.
 --- */
 
 bool SRXEFlashRead(uint32_t addr, uint8_t *buffer, uint16_t count) {
-	int i;
-
+	_srxe_spi_wait();	// the LCD may still be using the SPI
 	srxeDigitalWrite(FLASH_CS, LOW);
 	_srxe_spi_transfer(0x03); // issue read instruction
 	// send 3-uint8_t address (big-endian order)
 	_srxe_spi_transfer((uint8_t)(addr >> 16)); // AD1
 	_srxe_spi_transfer((uint8_t)(addr >> 8));	 // AD2
 	_srxe_spi_transfer((uint8_t)addr);		 // AD3
-	for (i = 0; i < count; i++)					 // read the uint8_ts out
-		*buffer++ = _srxe_spi_transfer(0); // need to write something to read from SPI
+	_srxe_spi_read_block(buffer, count);		// read the uint8_ts out
 
 	srxeDigitalWrite(FLASH_CS, HIGH); // de-activate
 	return true;
@@ -0,0 +1,287 @@
+/* ************************************************************************************
+* File:	lcdband.h
+* Date:	2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+
+### LCD Band
+**Overlapping Shapes Without a Frame Buffer**
+
+The direct draw functions send every shape as it is drawn; where shapes overlap, the pixels underneath are sent and then covered
+_(eg: the bitmap and the rectangle of a `UI_MENU_ROUND_END` menu item)_.
+
+When `LCD_BAND` is defined, shapes may be recorded in a display list and rendered together.
+The area covered by the shapes is built a few lines at a time _(a band)_ in RAM with the shapes applied in the order they were recorded.
+Each band is then sent once. Every pixel of the area is sent exactly once and all shapes are sent through a single LCD window.
+
+The band is `LCD_BAND_LINES` _(default 8)_ lines of the full width of the screen; 8 lines use 1KB of RAM.
+The display list holds `LCD_BAND_ITEMS` _(default 16)_ shapes.
+
+A typical use:
+```C
+lcdBandBegin(LCD_WHITE);
+lcdBandBitmap(x, y, menu_ball18, false);
+lcdBandRectangle(x, y, 20, 18, LCD_ERASE);
+lcdBandText("Menu", x + 3, y + 2);
+lcdBandRender();
+```
+
+**Notes:**
+The shapes use the current colors and font at the time they are recorded. Text and bitmaps are not copied; they must remain valid until `lcdBandRender()`.
+Any part of the area which is not covered by a shape is filled with the background color given to `lcdBandBegin()`.
+Horizontal dimensions are in display triplets, not real pixels.
+Vertical dimensions are always in real pixels.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_LCDBAND_
+#define __SRXE_LCDBAND_
+
+#ifdef LCD_BAND
+
+#include "common.h"
+#include "lcdbase.h"
+#include "lcddraw.h"
+#include "lcdtext.h"
+
+#ifndef LCD_BAND_LINES
+#define LCD_BAND_LINES 8
+#endif
+
+#ifndef LCD_BAND_ITEMS
+#define LCD_BAND_ITEMS 16
+#endif
+
+#define _LCD_BAND_RECTANGLE	0
+#define _LCD_BAND_BITMAP	1
+#define _LCD_BAND_TEXT		2
+
+typedef struct {
+	uint8_t type;
+	uint8_t mode;				// rectangle mode, bitmap invert, or text font
+	uint8_t x, y, cx, cy;		// the area of the shape, clipped to the screen
+	uint8_t fg, bg;				// the colors as triplets
+	const void *data;			// the bitmap or the text
+	_LCD_BITMAP_RLE rle;		// the decoder of a version 1 bitmap
+} _LCD_BAND_ITEM;
+
+static _LCD_BAND_ITEM _lcd_band_items[LCD_BAND_ITEMS];
+static uint8_t _lcd_band_count;
+static uint8_t _lcd_band_bg;
+static uint8_t _lcd_band[LCD_BAND_LINES][LCD_WIDTH];
+
+// add a shape to the display list; returns NULL when the list is full or the shape is not on the screen
+// the callers tell the two apart with _lcd_band_count; a shape which is not on the screen is skipped and is not an error
+static _LCD_BAND_ITEM *_lcd_band_add(uint8_t type, int x, int y, int cx, int cy) {
+	if (_lcd_band_count >= LCD_BAND_ITEMS)
+		return NULL;
+	if ((x < 0) || (y < 0) || (x >= LCD_WIDTH) || (y >= LCD_HEIGHT) || (cx < 1) || (cy < 1))
+		return NULL;
+
+	if ((x + cx) > LCD_WIDTH)	cx = LCD_WIDTH - x;
+	if ((y + cy) > LCD_HEIGHT)	cy = LCD_HEIGHT - y;
+
+	_LCD_BAND_ITEM *item = &_lcd_band_items[_lcd_band_count++];
+	item->type = type;
+	item->x = x;
+	item->y = y;
+	item->cx = cx;
+	item->cy = cy;
+	item->fg = lcdColorTripletGetF();
+	item->bg = lcdColorTripletGetB();
+	return item;
+}
+
+// apply a rectangle to one row; the same pixels as lcdRectangle()
+static void _lcd_band_rectangle_row(_LCD_BAND_ITEM *item, uint8_t *row, uint8_t y) {
+	uint8_t *p = &row[item->x];
+
+	if ((item->mode == LCD_FILLED) || (item->mode == LCD_ERASE))
+		memset(p, item->bg, item->cx);
+
+	if (item->mode != LCD_ERASE) {
+		if ((y == item->y) || (y == (item->y + item->cy - 1))) {
+			memset(p, item->fg, item->cx);	// top and bottom
+		} else {
+			p[0] = (item->fg & 0b11100000) | (item->bg & 0b00011111);				// left pixel
+			p[item->cx - 1] = (item->fg & 0b00000011) | (item->bg & 0b11111100);	// right pixel
+		}
+	}
+}
+
+// decode the next row of a bitmap; the rows are always decoded in order
+static void _lcd_band_bitmap_row(_LCD_BAND_ITEM *item, uint8_t *row, uint8_t y) {
+	const uint8_t *btmp = (const uint8_t *)item->data;
+	uint8_t flags = pgm_read_byte_near(btmp + 1);
+	uint8_t *p = &row[item->x];
+
+	if (flags & BITMAP_V2) {
+		uint16_t height = pgm_read_byte_near(btmp + 2) + (pgm_read_byte_near(btmp + 3) << 8);
+		_lcd_bitmap_v2_row(btmp, height, y - item->y, 0, item->cx, p);
+	} else {
+		// the full row is decoded even if it is clipped
+		uint8_t width = TRIPLET_FROM_ACTUAL(pgm_read_byte_near(btmp) + (flags << 8));
+		_lcd_bitmap_rle_row(btmp, &item->rle, width, 0, item->cx, p);
+	}
+
+	if (item->mode) {
+		for (uint8_t i = 0; i < item->cx; i++)
+			p[i] = ~p[i];
+	}
+}
+
+// compose one row of text; the same pixels as lcdPutStringAt()
+static void _lcd_band_text_row(_LCD_BAND_ITEM *item, uint8_t *row, uint8_t y) {
+	uint8_t buffer[LCD_WIDTH + _LCD_TEXT_MAX_CELL];
+	FONTOBJECT *font = &_srxe_fonts[item->mode];
+	uint8_t r = (y - item->y) / ((font->scale & FONT_DOUBLE_HEIGHT) ? 2 : 1);
+	uint8_t glyph_width = font->width * ((font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1);
+	uint8_t cell = TRIPLET_FROM_ACTUAL(glyph_width + TRIPLET_OFFSET(glyph_width));
+
+	_lcd_text_lut_set(item->fg & 0x3, item->bg & 0x3);
+	_lcd_text_row(buffer, (const char *)item->data, (item->cx + cell - 1) / cell, font, r);
+	memcpy(&row[item->x], buffer, item->cx);
+}
+
+
+/* ---
+#### void lcdBandBegin(uint8_t bg)
+
+Start a new display list. Any part of the rendered area which is not covered by a shape is filled with the `bg` color.
+--- */
+void lcdBandBegin(uint8_t bg) {
+	if (bg > LCD_BLACK)
+		bg = LCD_BLACK;
+	_lcd_band_bg = _lcd_color_to_byte[bg];
+	_lcd_band_count = 0;
+}
+
+/* ---
+#### bool lcdBandRectangle(int x, int y, int cx, int cy, uint8_t mode)
+
+Add a rectangle to the display list; the same as `lcdRectangle()`.
+Returns `false` if the display list is full. A rectangle which is not on the screen is skipped and returns `true`.
+--- */
+bool lcdBandRectangle(int x, int y, int cx, int cy, uint8_t mode) {
+	// the same clipping as lcdRectangle()
+	if (x < 0) x = 0;
+	if (x > (LCD_WIDTH - 1))		x = LCD_WIDTH - 1;
+	if (y < 0)						y = 0;
+	if (y > (LCD_HEIGHT - 1))		y = LCD_HEIGHT - 1;
+
+	_LCD_BAND_ITEM *item = _lcd_band_add(_LCD_BAND_RECTANGLE, x, y, cx, cy);
+	if (!item)
+		return (_lcd_band_count < LCD_BAND_ITEMS);
+	item->mode = mode;
+	return true;
+}
+
+/* ---
+#### bool lcdBandBitmap(int x, int y, const uint8_t *bitmap, bool invert)
+
+Add a version 1 or version 2 bitmap to the display list; the same as `lcdBitmap()`.
+Returns `false` if the display list is full. A bitmap which is not on the screen is skipped and returns `true`.
+--- */
+bool lcdBandBitmap(int x, int y, const uint8_t *btmp, bool invert) {
+	int width = pgm_read_byte_near(btmp) + ((pgm_read_byte_near(btmp + 1) & ~BITMAP_V2) << 8);
+	int height = pgm_read_byte_near(btmp + 2) + (pgm_read_byte_near(btmp + 3) << 8);
+
+	_LCD_BAND_ITEM *item = _lcd_band_add(_LCD_BAND_BITMAP, x, y, TRIPLET_FROM_ACTUAL(width), height);
+	if (!item)
+		return (_lcd_band_count < LCD_BAND_ITEMS);
+	item->mode = invert;
+	item->data = btmp;
+	return true;
+}
+
+/* ---
+#### bool lcdBandText(const char *text, int x, int y)
+
+Add text to the display list using the current font and colors; the same as `lcdPutStringAt()`.
+Returns `false` if the display list is full or a character of the font is too wide for the band renderer.
+Empty text or text which is not on the screen is skipped and returns `true`.
+
+**Note:** the current LCD position is not changed.
+--- */
+bool lcdBandText(const char *text, int x, int y) {
+	FONTOBJECT *font = _lcd_font_get_pointer();
+	uint8_t glyph_width = font->width * ((font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1);
+	uint8_t cell = TRIPLET_FROM_ACTUAL(glyph_width + TRIPLET_OFFSET(glyph_width));
+	uint16_t count = strlen(text);
+
+	if (!cell || (cell > _LCD_TEXT_MAX_CELL))
+		return false;
+	if (!count)
+		return true;
+
+	_LCD_BAND_ITEM *item = _lcd_band_add(_LCD_BAND_TEXT, x, y, count * cell, lcdFontHeightGet());
+	if (!item)
+		return (_lcd_band_count < LCD_BAND_ITEMS);
+	item->mode = lcdFontGetNum();
+	item->data = text;
+	return true;
+}
+
+/* ---
+#### void lcdBandRender()
+
+Draw the display list and empty it.
+The area covered by all of the shapes is sent one band at a time through a single LCD window.
+--- */
+void lcdBandRender() {
+	if (!_lcd_init) return;
+	if (!_lcd_band_count) return;
+
+	// the area covered by all of the shapes
+	uint8_t x0 = LCD_WIDTH, y0 = LCD_HEIGHT, x1 = 0, y1 = 0;
+	for (uint8_t i = 0; i < _lcd_band_count; i++) {
+		_LCD_BAND_ITEM *item = &_lcd_band_items[i];
+		if (item->x < x0)					x0 = item->x;
+		if (item->y < y0)					y0 = item->y;
+		if ((item->x + item->cx) > x1)		x1 = item->x + item->cx;
+		if ((item->y + item->cy) > y1)		y1 = item->y + item->cy;
+		if (item->type == _LCD_BAND_BITMAP) {
+			item->rle.index = 4;	// the RLE data follows the width and height
+			item->rle.run = 0;
+		}
+	}
+	uint8_t cx = x1 - x0;
+
+	_lcd_set_active_area(x0, y0, cx, y1 - y0);
+	for (uint8_t band = y0; band < y1; band += LCD_BAND_LINES) {
+		uint8_t lines = ((y1 - band) < LCD_BAND_LINES) ? (y1 - band) : LCD_BAND_LINES;
+
+		for (uint8_t l = 0; l < lines; l++)
+			memset(&_lcd_band[l][x0], _lcd_band_bg, cx);
+
+		// the shapes are applied in the order they were recorded so later shapes are on top
+		for (uint8_t i = 0; i < _lcd_band_count; i++) {
+			_LCD_BAND_ITEM *item = &_lcd_band_items[i];
+			for (uint8_t l = 0; l < lines; l++) {
+				uint8_t y = band + l;
+				if ((y < item->y) || (y >= (item->y + item->cy)))
+					continue;
+				switch (item->type) {
+					case _LCD_BAND_RECTANGLE:	_lcd_band_rectangle_row(item, _lcd_band[l], y);	break;
+					case _LCD_BAND_BITMAP:		_lcd_band_bitmap_row(item, _lcd_band[l], y);		break;
+					case _LCD_BAND_TEXT:		_lcd_band_text_row(item, _lcd_band[l], y);		break;
+				}
+			}
+		}
+
+		for (uint8_t l = 0; l < lines; l++)
+			_lcd_write_data_block(&_lcd_band[l][x0], cx);
+	}
+	_lcd_end_active_area();
+
+	_lcd_band_count = 0;
+}
+
+#endif // LCD_BAND
+#endif // __SRXE_LCDBAND_
@@ -48,6 +48,7 @@ There are definitions for the colors to improve code:
 #define LCD_WIDTH  128	// 0..127 = 128 ==> 128 * 3 = 384
 #define LCD_HEIGHT 136	// 0..135 = 136
 #define LCD_DRIVER_HEIGHT 160
+#define LCD_HIDDEN_LINES (LCD_DRIVER_HEIGHT - LCD_HEIGHT)	// driver lines below the visible screen; used by lcdPageFlipBegin()
 
 typedef char (*char_callback)(char);
 
@@ -92,6 +93,10 @@ FONTOBJECT _srxe_fonts[FONTS_MAX];
 #define FONT_DOUBLE_HEIGHT 0x2
 #define FONT_DOUBLED (FONT_DOUBLE_WIDTH | FONT_DOUBLE_HEIGHT)
 
+// the font data is pre-packed triplet masks (font_gen.py --triplets) rather than 1-bit pixel rows
+// triplet fonts may use FONT_DOUBLE_HEIGHT but not FONT_DOUBLE_WIDTH
+#define FONT_TRIPLETS 0x80
+
 // --------------------------------------------------------------------------------------------
 
 // definitions for fill functions
@@ -128,7 +133,9 @@ uint8_t _srxe_active_font_num;
 
 // --------------------------------------------------------------------------------------------
 
-static uint8_t _lcd_scroll_offset, _lcd_scroll_area;
+static uint8_t _lcd_scroll_offset, _lcd_scroll_area, _lcd_scroll_top;
+static uint8_t _lcd_page_height;	// height of the page flip band; 0 when page flipping is not active
+static uint8_t _lcd_page_visible;	// 0 = the band shows its own rows; 1 = the band shows the hidden rows
 
 // --------------------------------------------------------------------------------------------
 
@@ -225,31 +232,414 @@ typedef enum {
 	MODE_COMMAND
 } DC_MODE;
 
+#ifndef LCD_ASYNC_QUEUE	// the queue sets the D/C pin itself
 // Sets the D/C pin to data or command mode
 static void _lcd_set_mode(int iMode) {
 	srxeDigitalWrite(LCD_DC, (iMode == MODE_DATA));
 } /* _lcd_set_mode() */
+#endif
+
+// --------------------------------------------------------------------------------------------
+
+/* ---
+### LCD Transmit Queue
+
+When `LCD_ASYNC_QUEUE` is defined, LCD writes are queued and sent by the SPI interrupt (`SPI_STC`).
+The drawing functions return as soon as their data is queued so the clock, keyboard, RF, and the kernal message loop
+keep running while the screen updates.
+
+A queue entry is a _segment_: a command byte, a block of data from RAM or PROGMEM, or one byte repeated.
+The queue holds `LCD_QUEUE_SIZE` segments _(default 16)_. When it is full, the caller waits for a free slot.
+
+**Notes:**
+ - RAM data given to `lcdQueueData()` must not change until the queue has sent it _(use `lcdQueueFence()`)_
+ - internal writes of more than 4 bytes from RAM _(eg: text glyphs)_ wait for the queue to empty and are then sent directly
+ - there is one interrupt per byte; at the SRXE SPI clock the interrupt overhead is longer than the byte itself
+ so the queue trades raw throughput for a responsive main loop
+ - the FLASH functions and `powerSleep()` wait for the queue to empty before using the SPI
+ - do not queue with interrupts disabled; a full queue would never drain
+ - `SCREEN_GRABBER` is not supported with the queue
+
+Without `LCD_ASYNC_QUEUE`, all LCD writes are synchronous and `lcdQueueBusy()` and `lcdQueueFence()` do nothing.
+--- */
+
+#ifdef LCD_ASYNC_QUEUE
+
+#ifdef SCREEN_GRABBER
+#error "SCREEN_GRABBER is not supported with LCD_ASYNC_QUEUE"
+#endif
+
+#ifndef LCD_QUEUE_SIZE
+#define LCD_QUEUE_SIZE 16	// must be a power of 2
+#endif
+
+#define _LCD_SEG_COMMAND	0	// one command byte
+#define _LCD_SEG_INLINE		1	// up to 4 data bytes held in the segment
+#define _LCD_SEG_DATA		2	// data from RAM
+#define _LCD_SEG_DATA_P		3	// data from PROGMEM
+#define _LCD_SEG_REPEAT		4	// one data byte repeated
+
+#define _LCD_SEG_INLINE_MAX	4
+
+typedef struct {
+	uint8_t type;
+	uint16_t count;
+	union {
+		const uint8_t *data;
+		uint8_t bytes[_LCD_SEG_INLINE_MAX];
+	} u;
+} _LCD_SEGMENT;
+
+static _LCD_SEGMENT _lcd_queue[LCD_QUEUE_SIZE];
+static volatile uint8_t _lcd_queue_head, _lcd_queue_tail;	// the interrupt sends from the tail
+static const uint8_t *_lcd_queue_ptr;						// next byte of the segment being sent
+static uint16_t _lcd_queue_remaining;						// bytes left in the segment being sent
+
+// the interrupt changes the CS and DC with single instruction (sbi/cbi) port writes
+#define _LCD_QUEUE_SELECT()		(PORTE &= ~(1 << PIN7))	// LCD_CS
+#define _LCD_QUEUE_DESELECT()	(PORTE |= (1 << PIN7))
+#define _LCD_QUEUE_COMMAND()	(PORTD &= ~(1 << PIN6))	// LCD_DC
+#define _LCD_QUEUE_DATA()		(PORTD |= (1 << PIN6))
+
+// the next byte of the segment being sent
+static inline uint8_t _lcd_queue_byte(_LCD_SEGMENT *seg) {
+	_lcd_queue_remaining--;
+	switch (seg->type) {
+		case _LCD_SEG_REPEAT:	return seg->u.bytes[0];
+		case _LCD_SEG_DATA_P:	return pgm_read_byte(_lcd_queue_ptr++);
+		default:				return *_lcd_queue_ptr++;
+	}
+}
+
+// start sending the segment at the tail; the queue must not be empty
+static void _lcd_queue_start() {
+	_LCD_SEGMENT *seg = &_lcd_queue[_lcd_queue_tail];
+
+	if (seg->type == _LCD_SEG_COMMAND)
+		_LCD_QUEUE_COMMAND();
+	else
+		_LCD_QUEUE_DATA();
+	_lcd_queue_ptr = ((seg->type == _LCD_SEG_DATA) || (seg->type == _LCD_SEG_DATA_P)) ? seg->u.data : seg->u.bytes;
+	_lcd_queue_remaining = seg->count;
+	SPDR = _lcd_queue_byte(seg);
+}
+
+ISR(SPI_STC_vect) {
+	if (_lcd_queue_remaining) {
+		SPDR = _lcd_queue_byte(&_lcd_queue[_lcd_queue_tail]);
+		return;
+	}
+
+	_lcd_queue_tail = (_lcd_queue_tail + 1) & (LCD_QUEUE_SIZE - 1);
+	if (_lcd_queue_tail != _lcd_queue_head) {
+		_lcd_queue_start();
+		return;
+	}
+
+	// the queue is empty; release the LCD and the SPI
+	SPCR &= ~(1 << SPIE);
+	_LCD_QUEUE_DESELECT();
+	_LCD_QUEUE_DATA();
+	_srxe_spi_busy = false;
+}
+
+// get the next free segment, waiting for the interrupt if the queue is full
+static _LCD_SEGMENT *_lcd_queue_reserve() {
+	uint8_t next = (_lcd_queue_head + 1) & (LCD_QUEUE_SIZE - 1);
+
+	while (next == _lcd_queue_tail) {
+	}
+	return &_lcd_queue[_lcd_queue_head];
+}
+
+// add the reserved segment to the queue and start the interrupt if it is idle
+static void _lcd_queue_commit() {
+	uint8_t sreg = SREG;
+
+	cli();
+	_lcd_queue_head = (_lcd_queue_head + 1) & (LCD_QUEUE_SIZE - 1);
+	if (!_srxe_spi_busy) {
+		_srxe_spi_busy = true;
+		_LCD_QUEUE_SELECT();
+		SPCR |= (1 << SPIE);
+		_lcd_queue_start();
+	}
+	SREG = sreg;
+}
+
+/* ---
+#### void lcdQueueCommand(uint8_t c)
+
+Queue a command byte for the LCD controller.
+--- */
+void lcdQueueCommand(uint8_t c) {
+	_LCD_SEGMENT *seg = _lcd_queue_reserve();
+
+	seg->type = _LCD_SEG_COMMAND;
+	seg->count = 1;
+	seg->u.bytes[0] = c;
+	_lcd_queue_commit();
+}
+
+/* ---
+#### void lcdQueueData(const uint8_t *data, uint16_t len)
+
+Queue a block of data from RAM.
+
+Up to 4 bytes are copied into the queue. A longer block is sent from the caller's memory and must not change until it has been sent.
+--- */
+void lcdQueueData(const uint8_t *data, uint16_t len) {
+	if (!len)
+		return;
+
+	_LCD_SEGMENT *seg = _lcd_queue_reserve();
+
+	seg->count = len;
+	if (len <= _LCD_SEG_INLINE_MAX) {
+		seg->type = _LCD_SEG_INLINE;
+		memcpy(seg->u.bytes, data, len);
+	} else {
+		seg->type = _LCD_SEG_DATA;
+		seg->u.data = data;
+	}
+	_lcd_queue_commit();
+}
+
+/* ---
+#### void lcdQueueDataP(const uint8_t *data, uint16_t len)
+
+Queue a block of data from PROGMEM.
+--- */
+void lcdQueueDataP(const uint8_t *data, uint16_t len) {
+	if (!len)
+		return;
+
+	_LCD_SEGMENT *seg = _lcd_queue_reserve();
+
+	seg->type = _LCD_SEG_DATA_P;
+	seg->count = len;
+	seg->u.data = data;
+	_lcd_queue_commit();
+}
+
+/* ---
+#### void lcdQueueRepeat(uint8_t value, uint16_t count)
+
+Queue the same data byte `count` times _(eg: a solid fill)_.
+--- */
+void lcdQueueRepeat(uint8_t value, uint16_t count) {
+	if (!count)
+		return;
+
+	_LCD_SEGMENT *seg = _lcd_queue_reserve();
+
+	seg->type = _LCD_SEG_REPEAT;
+	seg->count = count;
+	seg->u.bytes[0] = value;
+	_lcd_queue_commit();
+}
+
+/* ---
+#### bool lcdQueueBusy()
+
+Returns `true` while queued LCD data is still being sent.
+--- */
+bool lcdQueueBusy() {
+	return _srxe_spi_busy;
+}
+
+/* ---
+#### void lcdQueueFence()
+
+Wait until everything queued has been sent to the LCD.
+--- */
+void lcdQueueFence() {
+	_srxe_spi_wait();
+}
+
+#else
+#define lcdQueueBusy()	(false)
+#define lcdQueueFence()	((void) 0)
+#endif
+
+// --------------------------------------------------------------------------------------------
+
+/* ---
+### LCD Window Cache
+
+Every draw operation opens a _window_ on the LCD controller with the column (`0x2a`), row (`0x2b`), and memory write (`0x2c`) commands.
+That is 11 bytes before any pixels are sent; often more than a text glyph itself.
+
+The LCD code tracks the controller's current window and write pointer:
+ - the column or the row command is skipped when its range is unchanged _(eg: text along one line only changes columns)_
+ - all three commands are skipped when the window is unchanged and the write pointer has wrapped back to its start
+
+When `LCD_WINDOW_STATS` is defined, counters record how many address commands were skipped and the bytes saved.
+--- */
+
+typedef struct {
+	uint8_t x0, x1, y0, y1;	// the controller's column and row range; 0xff when unknown
+	uint16_t size;			// triplets in the window
+	uint16_t pos;			// triplets written since the memory write command, modulo size
+	bool writing;			// the controller is still in memory write mode
+} _LCD_WINDOW;
+
+static _LCD_WINDOW _lcd_window;
+
+// forget the controller state; used when the controller is reset or its state is otherwise unknown
+static void _lcd_window_invalidate() {
+	_lcd_window.x0 = _lcd_window.x1 = _lcd_window.y0 = _lcd_window.y1 = 0xff;
+	_lcd_window.writing = false;
+}
+
+// track the write pointer as data is written into the window
+static void _lcd_window_advance(uint16_t len) {
+	if (!_lcd_window.writing)
+		return;	// these are command parameters
+	_lcd_window.pos += len;
+	while (_lcd_window.pos >= _lcd_window.size)
+		_lcd_window.pos -= _lcd_window.size;
+}
+
+#ifdef LCD_WINDOW_STATS
+typedef struct {
+	uint16_t windows;			// windows opened
+	uint16_t columns_skipped;	// 0x2a commands not sent
+	uint16_t rows_skipped;		// 0x2b commands not sent
+	uint16_t windows_reused;	// windows opened without sending any commands
+	uint32_t bytes_saved;		// command and parameter bytes not sent
+} LCDWINDOWSTATS;
+
+static LCDWINDOWSTATS _lcd_window_stats;
+
+#define _LCD_WINDOW_STAT(field, bytes)	do { _lcd_window_stats.field++; _lcd_window_stats.bytes_saved += (bytes); } while (0)
+
+/* ---
+#### LCDWINDOWSTATS* lcdWindowStatsGet()
+
+Returns the window cache counters _(only available when `LCD_WINDOW_STATS` is defined)_.
+
+The counters are `windows`, `columns_skipped`, `rows_skipped`, `windows_reused`, and `bytes_saved`.
+Use `lcdWindowStatsReset()` before an operation and `lcdWindowStatsGet()` after it to get the per-operation savings.
+--- */
+LCDWINDOWSTATS* lcdWindowStatsGet() {
+	return &_lcd_window_stats;
+}
+
+/* ---
+#### void lcdWindowStatsReset()
+
+Clear the window cache counters.
+--- */
+void lcdWindowStatsReset() {
+	memset(&_lcd_window_stats, 0, sizeof(_lcd_window_stats));
+}
+#else
+#define _LCD_WINDOW_STAT(field, bytes)	((void) 0)
+#endif
+
+#ifdef SRXE_PROFILE
+// only the outermost LCD write is timed; the window functions call the command and data functions
+static uint8_t _lcd_profile_depth;
+static uint32_t _lcd_profile_start;
+
+#define _LCD_PROFILE_BEGIN()	do { if (!_lcd_profile_depth++) _lcd_profile_start = clockMicros(); } while (0)
+#define _LCD_PROFILE_END()		do { if (!--_lcd_profile_depth) _srxe_profile.lcd_us += clockMicros() - _lcd_profile_start; } while (0)
+#else
+#define _LCD_PROFILE_BEGIN()	((void) 0)
+#define _LCD_PROFILE_END()		((void) 0)
+#endif
+
+// --------------------------------------------------------------------------------------------
 
 //
 // Write a one byte command to the LCD controller
 //
 static void _lcd_write_command(unsigned char c) {
+	// any command ends a memory write; only 0x2c starts one
+	_lcd_window.writing = (c == 0x2c);
+	_lcd_window.pos = 0;
+	SRXE_PROFILE_COUNT(lcd_commands, 1);
+
+#ifdef LCD_ASYNC_QUEUE
+	lcdQueueCommand(c);
+#else
+	_LCD_PROFILE_BEGIN();
 	srxeDigitalWrite(LCD_CS, LOW);
 	_lcd_set_mode(MODE_COMMAND);
 	_srxe_spi_transfer(c);
 	_lcd_set_mode(MODE_DATA);
 	srxeDigitalWrite(LCD_CS, HIGH);
+	_LCD_PROFILE_END();
+#endif
 } /* _lcd_write_command() */
 
 // Write a block of data to the LCD
 // Length can be anything from 1 to 17404 (whole display)
-void _lcd_write_data_block(uint8_t* data, uint8_t len) {
+void _lcd_write_data_block(const uint8_t* data, uint16_t len) {
+	_lcd_window_advance(len);
+	SRXE_PROFILE_COUNT(lcd_data_bytes, len);
+#ifdef LCD_ASYNC_QUEUE
+	// callers often pass a buffer on their stack; only short blocks can be copied into the queue
+	if (len <= _LCD_SEG_INLINE_MAX) {
+		lcdQueueData(data, len);
+		return;
+	}
+	lcdQueueFence();
+#endif
+	_LCD_PROFILE_BEGIN();
 	srxeDigitalWrite(LCD_CS, LOW);
-	for (uint8_t i = 0; i < len; i++) {
+#ifdef SCREEN_GRABBER
+	// the grabber needs to see every byte so we stay with the byte-at-a-time transfer
+	for (uint16_t i = 0; i < len; i++) {
 		_srxe_spi_transfer(data[i]);
 		LCD_STREAM_GRABBER(data[i]);
 	}
+#else
+	_srxe_spi_write_block(data, len);
+#endif
 	srxeDigitalWrite(LCD_CS, HIGH);
+	_LCD_PROFILE_END();
+}
+
+// Select the LCD for a series of _lcd_stream_repeat() calls (the queue manages the CS itself)
+static void _lcd_stream_begin() {
+#ifndef LCD_ASYNC_QUEUE
+	_LCD_PROFILE_BEGIN();
+	srxeDigitalWrite(LCD_CS, LOW);
+#endif
+}
+
+static void _lcd_stream_end() {
+#ifndef LCD_ASYNC_QUEUE
+	srxeDigitalWrite(LCD_CS, HIGH);
+	_LCD_PROFILE_END();
+#endif
+}
+
+// Stream the same byte `count` times to the LCD; must be between _lcd_stream_begin() and _lcd_stream_end()
+// this is used when many short runs are sent back to back (eg: RLE bitmaps)
+static void _lcd_stream_repeat(uint8_t value, uint16_t count) {
+	_lcd_window_advance(count);
+	SRXE_PROFILE_COUNT(lcd_data_bytes, count);
+#if defined(LCD_ASYNC_QUEUE)
+	lcdQueueRepeat(value, count);
+#elif defined(SCREEN_GRABBER)
+	for (uint16_t i = 0; i < count; i++) {
+		_srxe_spi_transfer(value);
+		LCD_STREAM_GRABBER(value);
+	}
+#else
+	_srxe_spi_write_repeat(value, count);
+#endif
+}
+
+// Write the same byte `count` times to the LCD
+// Count can be anything from 1 to 17408 (whole display) and no RAM buffer is used
+void _lcd_write_repeat(uint8_t value, uint16_t count) {
+	_lcd_stream_begin();
+	_lcd_stream_repeat(value, count);
+	_lcd_stream_end();
 }
 
 
@@ -293,15 +683,18 @@ void _lcd_run_commands(const unsigned char *pList) {
 	uint8_t cmd_buffer[4];
 	uint8_t val, count, len = 1;
 
+	_lcd_window_invalidate();	// the command lists may reset the controller
+
 	while (len != 0) {
 		len = pgm_read_byte(pList++);
 
 		if (len != 0) {
 			val = pgm_read_byte(pList++);
 
-			if (len == 99) // 99 means perform a delay
+			if (len == 99) { // 99 means perform a delay
+				lcdQueueFence();	// the delay is timed from when the previous commands reach the LCD
 				clockDelay(val);
-			else {
+			} else {
 				// send command with optional data
 				_lcd_write_command(val);
 				count = len - 1;
@@ -331,19 +724,56 @@ void _lcd_set_active_area(int x, int y, int cx, int cy) {
 		return; // invalid
 	}
 
-	_lcd_write_command(0x2a);	  	// set column address
-	cmd_buffer[0] = 0;				  	// start column high uint8_t
-	cmd_buffer[1] = x;			  		// start column low uint8_t
-	cmd_buffer[2] = 0;				  	// end col high uint8_t
-	cmd_buffer[3] = (x + cx - 1); 		// end col low uint8_t
-	_lcd_write_data_block(cmd_buffer, 4);
-	_lcd_write_command(0x2b); 		// set row address
-	cmd_buffer[0] = 0;			  		// start row high uint8_t
-	cmd_buffer[1] = y;			  		// start row low uint8_t
-	cmd_buffer[2] = 0;			  		// end row high uint8_t
-	cmd_buffer[3] = y + cy - 1;	  		// end row low uint8_t
-	_lcd_write_data_block(cmd_buffer, 4);
+	// with page flipping, windows inside the band are drawn on the page which is not visible
+	if (_lcd_page_height && !_lcd_page_visible && (y >= (LCD_HEIGHT - _lcd_page_height)) && ((y + cy) <= LCD_HEIGHT))
+		y += _lcd_page_height;
+
+	uint8_t x1 = x + cx - 1;
+	uint8_t y1 = y + cy - 1;
+	bool same_columns = ((_lcd_window.x0 == x) && (_lcd_window.x1 == x1));
+	bool same_rows = ((_lcd_window.y0 == y) && (_lcd_window.y1 == y1));
+
+#ifdef LCD_WINDOW_STATS
+	_lcd_window_stats.windows++;
+#endif
+	SRXE_PROFILE_COUNT(lcd_windows, 1);
+
+	// the same window with the write pointer back at its start needs no commands at all
+	if (same_columns && same_rows && _lcd_window.writing && (_lcd_window.pos == 0)) {
+		_LCD_WINDOW_STAT(windows_reused, 11);
+		LCD_STREAM_GRABBER_START(x, y, cx, cy);
+		return;
+	}
+
+	_LCD_PROFILE_BEGIN();
+
+	if (same_columns) {
+		_LCD_WINDOW_STAT(columns_skipped, 5);
+	} else {
+		_lcd_write_command(0x2a);	  	// set column address
+		cmd_buffer[0] = 0;				  	// start column high uint8_t
+		cmd_buffer[1] = x;			  		// start column low uint8_t
+		cmd_buffer[2] = 0;				  	// end col high uint8_t
+		cmd_buffer[3] = x1; 				// end col low uint8_t
+		_lcd_write_data_block(cmd_buffer, 4);
+		_lcd_window.x0 = x;
+		_lcd_window.x1 = x1;
+	}
+	if (same_rows) {
+		_LCD_WINDOW_STAT(rows_skipped, 5);
+	} else {
+		_lcd_write_command(0x2b); 		// set row address
+		cmd_buffer[0] = 0;			  		// start row high uint8_t
+		cmd_buffer[1] = y;			  		// start row low uint8_t
+		cmd_buffer[2] = 0;			  		// end row high uint8_t
+		cmd_buffer[3] = y1;	  				// end row low uint8_t
+		_lcd_write_data_block(cmd_buffer, 4);
+		_lcd_window.y0 = y;
+		_lcd_window.y1 = y1;
+	}
 	_lcd_write_command(0x2c); 	// write RAM
+	_lcd_window.size = cx * cy;
+	_LCD_PROFILE_END();
 
 	LCD_STREAM_GRABBER_START(x, y, cx, cy);
 } /* _lcd_set_active_area() */
@@ -398,18 +828,12 @@ Fill the entire screen with the specified color.
 void lcdFill(uint8_t ucData) {
 	if (!_lcd_init) return;
 
-	int y;
-	uint8_t temp[128];
-
 	LCD_STREAM_GRABBER_NEW();
 
 	_lcd_set_active_area(0, 0, LCD_WIDTH, LCD_HEIGHT);
 	LCD_STREAM_GRABBER_SKIP();	// we do not need to attempt and send all the blanking data
 
-	for (y = 0; y < LCD_HEIGHT; y++) {
-		memset(temp, ucData, LCD_WIDTH);		  // have to do this because the uint8_ts get overwritten
-		_lcd_write_data_block(temp, LCD_WIDTH); // fill with data uint8_t
-	}
+	_lcd_write_repeat(ucData, (uint16_t)LCD_WIDTH * LCD_HEIGHT);
 
 	_lcd_end_active_area();
 }
@@ -0,0 +1,259 @@
+/* ************************************************************************************
+* File:	lcdconsole.h
+* Date:	2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+
+### LCD Console
+**Scrolling Text Output**
+
+The console is a log style text area which uses the scroll feature of the LCD controller.
+When the console is full, a new line clears only the oldest line and moves the scroll start line;
+all the other lines are moved by the LCD controller. A new line costs one line of SPI data rather than a redraw of the whole text area.
+
+The console may leave fixed areas at the top and bottom of the screen for a title and the soft menus.
+
+When the console is active, `printf()` output to `PRINT_LCD` goes to the console and newline characters start a new line.
+
+Characters are collected and drawn a run at a time through a single LCD window, rather than one window per character.
+A run is drawn at a newline, when the line is full, at the end of each `printf()`, or by `lcdConsoleFlush()`.
+
+**Notes:**
+The console uses the scroll area of the LCD controller; `lcdScrollSet()`, `lcdPageFlipBegin()`, and the other scroll functions end the console.
+While the console is active, the rows of the console area are shown in scroll order; draw only in the fixed areas.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_LCDCONSOLE_
+#define __SRXE_LCDCONSOLE_
+
+#include "common.h"
+#include "lcdbase.h"
+#include "lcddraw.h"
+#include "lcdtext.h"
+
+static uint8_t _lcd_console_top;		// first row of the console; also the top of the scroll area
+static uint8_t _lcd_console_height;		// rows of the console area (top fixed area to bottom fixed area)
+static uint8_t _lcd_console_line_height;
+static uint8_t _lcd_console_lines;		// 0 when the console is not active
+static uint8_t _lcd_console_first;		// the line shown at the top of the console
+static uint8_t _lcd_console_line;		// the line being written, counted from the top of the console
+static uint8_t _lcd_console_font;
+static int _lcd_console_x;
+
+#define _LCD_CONSOLE_RUN_MAX	64		// characters collected before they are drawn; a whole line of the 6 pixel font
+static char _lcd_console_run[_LCD_CONSOLE_RUN_MAX];
+static uint8_t _lcd_console_run_count;
+
+// the driver row of a line, counted from the top of the console
+static uint8_t _lcd_console_row(uint8_t line) {
+	return _lcd_console_top + (((_lcd_console_first + line) % _lcd_console_lines) * _lcd_console_line_height);
+}
+
+// the console is only valid while the scroll area has not been changed by someone else
+static bool _lcd_console_valid() {
+	return (_lcd_console_lines && (_lcd_scroll_top == _lcd_console_top) && (_lcd_scroll_area == (_lcd_console_lines * _lcd_console_line_height)));
+}
+
+// erase one line of the console
+static void _lcd_console_erase(uint8_t line) {
+	_lcd_set_active_area(0, _lcd_console_row(line), LCD_WIDTH, _lcd_console_line_height);
+	_lcd_write_repeat(lcdColorTripletGetB(), (uint16_t)LCD_WIDTH * _lcd_console_line_height);
+	_lcd_end_active_area();
+}
+
+void lcdConsoleClear();
+
+// the width of a console character, in triplets
+static uint8_t _lcd_console_cell() {
+	FONTOBJECT *font = &_srxe_fonts[_lcd_console_font];
+	return TRIPLET_FROM_ACTUAL(TRIPLET_CEILING(font->width * ((font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1)));
+}
+
+// draw the collected characters at the end of the current line through one window
+static void _lcd_console_flush() {
+	if (!_lcd_console_run_count)
+		return;
+
+	int x = lcdPositionGetX();
+	int y = lcdPositionGetY();
+	uint8_t font = lcdFontGetNum();
+	lcdFontSet(_lcd_console_font);
+
+	lcdPositionSet(_lcd_console_x, _lcd_console_row(_lcd_console_line));
+	_lcd_put_text(_lcd_console_run, _lcd_console_run_count);
+	_lcd_console_x += _lcd_console_run_count * _lcd_console_cell();
+	_lcd_console_run_count = 0;
+
+	lcdFontSet(font);
+	lcdPositionSet(x, y);
+}
+
+static void _lcd_console_newline() {
+	_lcd_console_x = 0;
+	if (_lcd_console_line < (_lcd_console_lines - 1)) {
+		_lcd_console_line++;
+		return;
+	}
+
+	// the console is full; the oldest line becomes the new bottom line
+	_lcd_console_erase(0);
+	_lcd_console_first = (_lcd_console_first + 1) % _lcd_console_lines;
+
+	uint8_t b = _lcd_console_row(0);
+	_lcd_scroll_offset = b - _lcd_console_top;
+	_lcd_write_command(0x37); // scroll start address
+	_lcd_write_data_block(&b, 1);
+}
+
+
+/* ---
+#### bool lcdConsoleBegin(int top, int bottom)
+
+Start the console between a fixed area of `top` rows and a fixed area of `bottom` rows.
+The console uses the current font; its line height is the height of the font.
+The console area is cleared with the current background color.
+
+Returns `false` if fewer than two lines fit.
+
+**Note:** Vertical dimensions are always in real pixels.
+--- */
+bool lcdConsoleBegin(int top, int bottom) {
+	if (!_lcd_init) return false;
+
+	if ((top < 0) || (bottom < 0) || ((top + bottom) >= LCD_HEIGHT))
+		return false;
+
+	uint8_t height = LCD_HEIGHT - top - bottom;
+	uint8_t line_height = lcdFontHeightGet();
+	uint8_t lines = height / line_height;
+	if (lines < 2)
+		return false;
+
+	// the bottom fixed area must be at the end of the driver lines so it includes the hidden lines
+	// any rows left over below the last line are also fixed
+	lcdScrollSet(top, lines * line_height, LCD_DRIVER_HEIGHT - top - (lines * line_height));
+
+	_lcd_console_top = top;
+	_lcd_console_height = height;
+	_lcd_console_line_height = line_height;
+	_lcd_console_lines = lines;
+	_lcd_console_font = lcdFontGetNum();
+
+	lcdConsoleClear();
+	return true;
+}
+
+/* ---
+#### void lcdConsoleEnd()
+
+Stop the console and restore the default scroll area.
+The console lines are shown in their own rows again, so the console area should be cleared or redrawn.
+--- */
+void lcdConsoleEnd() {
+	if (!_lcd_console_lines) return;
+	if (_lcd_console_valid())
+		_lcd_console_flush();
+	_lcd_console_lines = 0;
+	lcdScrollReset();
+}
+
+/* ---
+#### bool lcdConsoleActive()
+
+Returns `true` while the console is active.
+--- */
+bool lcdConsoleActive() {
+	if (_lcd_console_lines && !_lcd_console_valid())
+		_lcd_console_lines = 0;	// the scroll area has been changed
+	return (_lcd_console_lines != 0);
+}
+
+/* ---
+#### void lcdConsoleClear()
+
+Erase the console with the current background color and start again at its first line.
+--- */
+void lcdConsoleClear() {
+	if (!lcdConsoleActive()) return;
+
+	_lcd_console_first = 0;
+	_lcd_console_line = 0;
+	_lcd_console_x = 0;
+	_lcd_console_run_count = 0;
+
+	// the scroll start is back at the top so the console rows are in order again
+	_lcd_scroll_offset = 0;
+	_lcd_write_command(0x37); // scroll start address
+	_lcd_write_data_block(&_lcd_console_top, 1);
+
+	_lcd_set_active_area(0, _lcd_console_top, LCD_WIDTH, _lcd_console_height);
+	_lcd_write_repeat(lcdColorTripletGetB(), (uint16_t)LCD_WIDTH * _lcd_console_height);
+	_lcd_end_active_area();
+}
+
+/* ---
+#### void lcdConsolePutChar(char c)
+
+Add a character to the console using the console font and the current colors.
+A newline (`\n`) starts a new line and a return (`\r`) moves to the start of the current line.
+Characters which do not fit on the line are wrapped to the next line.
+
+The character is collected with the others of the line and is drawn at the next newline, when the line is full,
+or by `lcdConsoleFlush()`. The collected characters are drawn in the colors current at that time.
+
+The current LCD position and font are not changed.
+--- */
+void lcdConsolePutChar(char c) {
+	if (!lcdConsoleActive()) return;
+
+	if (c == '\n') {
+		_lcd_console_flush();
+		_lcd_console_newline();
+		return;
+	}
+	if (c == '\r') {
+		_lcd_console_flush();
+		_lcd_console_x = 0;
+		return;
+	}
+	if (!c)
+		return;
+
+	if ((_lcd_console_x + ((_lcd_console_run_count + 1) * _lcd_console_cell())) > LCD_WIDTH) {
+		_lcd_console_flush();
+		_lcd_console_newline();
+	}
+	_lcd_console_run[_lcd_console_run_count++] = c;
+	if (_lcd_console_run_count == _LCD_CONSOLE_RUN_MAX)
+		_lcd_console_flush();
+}
+
+/* ---
+#### void lcdConsoleFlush()
+
+Draw the characters added with `lcdConsolePutChar()` which have not been drawn yet.
+--- */
+void lcdConsoleFlush() {
+	if (!lcdConsoleActive()) return;
+	_lcd_console_flush();
+}
+
+/* ---
+#### void lcdConsolePutString(const char* text)
+
+Add a string to the console and draw it; see `lcdConsolePutChar()`.
+--- */
+void lcdConsolePutString(const char *text) {
+	while (*text)
+		lcdConsolePutChar(*text++);
+	lcdConsoleFlush();
+}
+
+#endif // __SRXE_LCDCONSOLE_
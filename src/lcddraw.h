@@ -19,6 +19,8 @@
 #define __SRXE_LCDDRAW_
 
 #include "common.h"
+#include "clock.h"
+#include "flash.h"
 #include "lcdbase.h"
 
 /* ---
@@ -31,13 +33,8 @@ Draw a horizontal line with a given thickness.
 void lcdHorizontalLine(int x, int y, int length, int thickness) {
 	if (!_lcd_init) return;
 
-	uint8_t bTemp[128];
-	memset(bTemp, lcdColorTripletGetF(), length);
-
 	_lcd_set_active_area(x, y, length, thickness);
-	for (int i = 0; i < thickness; i++) {
-		_lcd_write_data_block(bTemp, length);
-	}
+	_lcd_write_repeat(lcdColorTripletGetF(), length * thickness);
 	_lcd_end_active_area();
 }
 
@@ -51,7 +48,6 @@ Draw a vertical line. Thickness from 1 to 3 is supported.
 
 void lcdVerticalLine(int x, int y, int height, int thickness) {
 	if (!_lcd_init) return;
-	uint8_t bTemp[136];
 
 	// implement thickness = try repeating entire instruction set first, then see if it can be optimized like with horizontal
 
@@ -64,18 +60,117 @@ void lcdVerticalLine(int x, int y, int height, int thickness) {
 
 	if (thickness == 1)	color = (fg & 0b00011100) | (bg & 0b11100011); // use middle pixel of triplet
 	if (thickness == 2)	color = (fg & 0b11111100) | (bg & 0b00000011); // use left and middle pixel of triplet
-	memset(bTemp, color, height);
 
 	_lcd_set_active_area(x, y, 1, height);	// 1 = one triplet
-	_lcd_write_data_block(bTemp, height);
+	_lcd_write_repeat(color, height);
 	_lcd_end_active_area();
 }
 
+// the edge triplets of a rectangle; only the outer pixel of each is the foreground color
+#define _LCD_RECT_LEFT(fg, bg)	(((fg) & 0b11100000) | ((bg) & 0b00011111))
+#define _LCD_RECT_RIGHT(fg, bg)	(((fg) & 0b00000011) | ((bg) & 0b11111100))
+
+// stream the interior rows of a grid of filled rectangles; each cell is a left edge, a fill, and a right edge
+// a cell which is one triplet wide is only its right edge (the same pixels as drawing the edges one after the other)
+static void _lcd_rectangle_row(uint8_t cols, int cx, uint8_t fg, uint8_t bg) {
+	for (uint8_t c = 0; c < cols; c++) {
+		if (cx > 1)
+			_lcd_stream_repeat(_LCD_RECT_LEFT(fg, bg), 1);
+		if (cx > 2)
+			_lcd_stream_repeat(bg, cx - 2);
+		_lcd_stream_repeat(_LCD_RECT_RIGHT(fg, bg), 1);
+	}
+}
+
+/* ---
+#### void lcdRectangleGrid(int x, int y, uint8_t cols, uint8_t rows, int cx, int cy, uint8_t mode)
+
+Draw a table of `cols` by `rows` rectangles, each `cx` by `cy`, with its top left corner at `x`, `y`.
+The pixels are the same as drawing each rectangle with `lcdRectangle()` using the same `mode`.
+
+A filled or erased table is sent through a single LCD window, one row at a time.
+A hollow table uses one window for each horizontal and vertical border line rather than four for each rectangle.
+Columns and rows which do not fit on the screen are not drawn.
+
+**Notes:**
+Horizontal dimensions are in display triplets, not real pixels.
+Vertical dimensions are always in real pixels.
+--- */
+void lcdRectangleGrid(int x, int y, uint8_t cols, uint8_t rows, int cx, int cy, uint8_t mode) {
+	if (!_lcd_init) return;
+
+	if ((x < 0) || (y < 0) || (x >= LCD_WIDTH) || (y >= LCD_HEIGHT) || (cx < 1) || (cy < 1))
+		return;
+	// clip in int; a count which does not fit would wrap in a uint8_t and open a window the LCD rejects
+	int fit_cols = (LCD_WIDTH - x) / cx;
+	int fit_rows = (LCD_HEIGHT - y) / cy;
+	if (cols > fit_cols)	cols = fit_cols;
+	if (rows > fit_rows)	rows = fit_rows;
+	if (!cols || !rows)
+		return;
+
+	uint8_t fg = lcdColorTripletGetF();
+	uint8_t bg = lcdColorTripletGetB();
+	int width = cols * cx;
+	int height = rows * cy;
+
+	if (mode == LCD_ERASE) {
+		_lcd_set_active_area(x, y, width, height);
+		_lcd_write_repeat(bg, width * height);
+		_lcd_end_active_area();
+		return;
+	}
+
+	// a rectangle which is at most 2 triplets wide or 2 rows high has no pixels which a hollow rectangle leaves untouched
+	if ((mode != LCD_HOLLOW) || (cx <= 2) || (cy <= 2)) {
+		_lcd_set_active_area(x, y, width, height);
+		_lcd_stream_begin();
+		for (int r = 0; r < height; r++) {
+			int line = r % cy;
+			if ((line == 0) || (line == (cy - 1)))
+				_lcd_stream_repeat(fg, width);	// top and bottom
+			else
+				_lcd_rectangle_row(cols, cx, fg, bg);
+		}
+		_lcd_stream_end();
+		_lcd_end_active_area();
+		return;
+	}
+
+	// hollow: each horizontal border is the bottom of one row and the top of the next
+	for (uint8_t k = 0; k <= rows; k++) {
+		int top = (k == 0) ? y : (y + (k * cy) - 1);
+		int lines = ((k == 0) || (k == rows)) ? 1 : 2;
+		_lcd_set_active_area(x, top, width, lines);
+		_lcd_write_repeat(fg, width * lines);
+		_lcd_end_active_area();
+	}
+
+	// each vertical border is the right edge of one column and the left edge of the next
+	for (uint8_t k = 0; k <= cols; k++) {
+		bool left = (k < cols), right = (k > 0);
+		_lcd_set_active_area(right ? (x + (k * cx) - 1) : x, y, (left && right) ? 2 : 1, height);
+		_lcd_stream_begin();
+		for (int r = 0; r < height; r++) {
+			int line = r % cy;
+			bool border = ((line == 0) || (line == (cy - 1)));
+			if (right)
+				_lcd_stream_repeat(border ? fg : _LCD_RECT_RIGHT(fg, bg), 1);
+			if (left)
+				_lcd_stream_repeat(border ? fg : _LCD_RECT_LEFT(fg, bg), 1);
+		}
+		_lcd_stream_end();
+		_lcd_end_active_area();
+	}
+}
+
 /* ---
 #### void lcdRectangle(int x, int y, int width, int height, bool filled)
 
 Draw a rectangle - hollow, filled, or erase area.
 
+A filled or erased rectangle is sent through a single LCD window; each row is generated as it is sent.
+
 **Notes:**
 A _filled_ rectangle is filled with the background color.
 Horizontal dimensions are in display triplets, not real pixels.
@@ -84,12 +179,6 @@ Vertical dimensions are always in real pixels.
 void lcdRectangle(int x, int y, int cx, int cy, uint8_t mode) {
 	if (!_lcd_init) return;
 
-	uint8_t bTemp[136];	// a full length vertical line is the maximum data block we will write
-
-#if 0
-	if (x < 0 || x > 127 || y < 0 || y > 135) return;
-	if (x + cx > 127 || y + cy > 135) return;
-#else
 	// clipping
 	if (x < 0) x = 0;
 	if (x > (LCD_WIDTH - 1))		x = LCD_WIDTH - 1;
@@ -97,61 +186,141 @@ void lcdRectangle(int x, int y, int cx, int cy, uint8_t mode) {
 	if (y > (LCD_HEIGHT - 1))		y = LCD_HEIGHT - 1;
 	if (x + cx > (LCD_WIDTH - 1))	cx = (LCD_WIDTH) - x;	// should this have the '-1'
 	if (y + cy > (LCD_HEIGHT))		cy = (LCD_HEIGHT) - y;	// should this have the '-1'
-#endif
 
-	uint8_t fg, bg;
-	fg = lcdColorTripletGetF();
-	bg = lcdColorTripletGetB();
+	lcdRectangleGrid(x, y, 1, 1, cx, cy, mode);
+}
+
+
+#define BITMAP_V2	0x80	// set in the high byte of the width of a version 2 bitmap
 
-	if ((mode == LCD_FILLED) || (mode == LCD_ERASE)) {
-		_lcd_set_active_area(x, y, cx, cy);
-		for (uint8_t i = 0; i < cy; i++) {
-			memset(bTemp, bg, cx);
-			_lcd_write_data_block(bTemp, cx);
+// the position within the run-length-encoded stream of a version 1 bitmap
+typedef struct {
+	uint16_t index;			// the next byte of the RLE data
+	uint8_t run, value;		// the remaining length and the value of the current run
+} _LCD_BITMAP_RLE;
+
+// Decode one row of a version 1 bitmap; a run may continue from the previous row
+// the triplets from sx to sx + sw - 1 are copied to out; nothing is copied when out is NULL (the row is skipped)
+static void _lcd_bitmap_rle_row(const uint8_t *btmp, _LCD_BITMAP_RLE *rle, uint8_t width, uint8_t sx, uint8_t sw, uint8_t *out) {
+	uint8_t pos = 0;
+	uint8_t end = sx + sw;
+
+	while (pos < width) {
+		if (!rle->run) {
+			rle->run = pgm_read_byte_near(btmp + rle->index++);
+			if (!rle->run)
+				return;	// end of the data
+			rle->value = pgm_read_byte_near(btmp + rle->index++);
 		}
-		_lcd_end_active_area();
+		uint8_t n = ((width - pos) < rle->run) ? (width - pos) : rle->run;
+		if (out) {
+			uint8_t first = (pos > sx) ? pos : sx;
+			uint8_t last = ((pos + n) < end) ? (pos + n) : end;
+			if (first < last)
+				memset(out + (first - sx), rle->value, last - first);
+		}
+		pos += n;
+		rle->run -= n;
 	}
+}
 
-	uint8_t color; // color bit for a triplet
-	if (mode != LCD_ERASE) {
-		// Left
-		_lcd_set_active_area(x, y, 1, cy);
-		color = (fg & 0b11100000) | (bg & 0b00011111);	// left pixel
-		memset(bTemp, color, cy);
-		_lcd_write_data_block(bTemp, cy);
-		_lcd_end_active_area();
+// Decode the triplets from sx to sx + sw - 1 of one row of a version 2 bitmap into out
+// the packets after the last triplet needed are not read
+static void _lcd_bitmap_v2_row(const uint8_t *btmp, uint16_t height, uint8_t r, uint8_t sx, uint8_t sw, uint8_t *out) {
+	const uint8_t *table = btmp + 4;
+	const uint8_t *p = table + (height * 2) + pgm_read_word_near(table + (r * 2));
+	uint8_t pos = 0;
+	uint8_t end = sx + sw;
+
+	while (pos < end) {
+		uint8_t c = pgm_read_byte_near(p++);
+		uint8_t n = (c & 0x7f) + 1;
+		uint8_t first = (pos > sx) ? pos : sx;
+		uint8_t last = ((pos + n) < end) ? (pos + n) : end;
+
+		if (c & 0x80) {
+			// a run of one triplet
+			if (first < last)
+				memset(out + (first - sx), pgm_read_byte_near(p), last - first);
+			p++;
+		} else {
+			// literal triplets
+			if (first < last)
+				memcpy_P(out + (first - sx), p + (first - pos), last - first);
+			p += n;
+		}
+		pos += n;
+	}
+}
 
-		// Right
-		_lcd_set_active_area((x + cx) - 1, y, 1, cy);
-		color = (fg & 0b00000011) | (bg & 0b11111100);	// right pixel
-		memset(bTemp, color, cy);
-		_lcd_write_data_block(bTemp, cy);
-		_lcd_end_active_area();
+/* ---
+#### void lcdBitmapClip(int x, int y, const uint8_t *bitmap, int sx, int sy, int sw, int sh, bool invert)
 
-		// Top
-		_lcd_set_active_area(x, y, cx, 1);
-		memset(bTemp, fg, cx);
-		_lcd_write_data_block(bTemp, cx);
-		_lcd_end_active_area();
+Draw part of a bitmap. The area `sx`, `sy`, `sw`, `sh` of the bitmap is drawn with its top left corner at `x`, `y`.
+The color map may be inverted.
 
-		// Bottom
-		_lcd_set_active_area(x, y + cy - 1, cx, 1);
-		memset(bTemp, fg, cx);
-		_lcd_write_data_block(bTemp, cx);
-		_lcd_end_active_area();
+The area is clipped to the bitmap and to the screen; `x` and `y` may be negative or partially off the screen.
+With a version 2 bitmap _(see `bitmap_gen.py --v2`)_, only the rows and triplets which are displayed are decoded.
+A version 1 bitmap is decoded from the start but only the displayed part is sent to the LCD.
+
+**Notes:**
+Horizontal dimensions are in display triplets, not real pixels.
+Vertical dimensions are always in real pixels.
+--- */
+void lcdBitmapClip(int x, int y, const uint8_t *btmp, int sx, int sy, int sw, int sh, bool invert) {
+	if (!_lcd_init) return;
+
+	uint8_t flags = pgm_read_byte_near(btmp + 1);
+	int width = TRIPLET_FROM_ACTUAL(pgm_read_byte_near(btmp) + ((flags & ~BITMAP_V2) << 8));
+	int height = pgm_read_byte_near(btmp + 2) + (pgm_read_byte_near(btmp + 3) << 8);
+
+	// clip the area to the bitmap
+	if (sx < 0)					{ x -= sx; sw += sx; sx = 0; }
+	if (sy < 0)					{ y -= sy; sh += sy; sy = 0; }
+	if ((sx + sw) > width)		sw = width - sx;
+	if ((sy + sh) > height)		sh = height - sy;
+
+	// clip the area to the screen
+	if (x < 0)					{ sx -= x; sw += x; x = 0; }
+	if (y < 0)					{ sy -= y; sh += y; y = 0; }
+	if ((x + sw) > LCD_WIDTH)	sw = LCD_WIDTH - x;
+	if ((y + sh) > LCD_HEIGHT)	sh = LCD_HEIGHT - y;
+
+	if ((sw <= 0) || (sh <= 0))
+		return;
+
+	uint8_t row[LCD_WIDTH];
+	_LCD_BITMAP_RLE rle = {4, 0, 0};	// the RLE data follows the width and height
+
+	if (!(flags & BITMAP_V2)) {
+		// a version 1 bitmap can only be read from the start
+		for (int r = 0; r < sy; r++)
+			_lcd_bitmap_rle_row(btmp, &rle, width, 0, 0, NULL);
 	}
 
+	_lcd_set_active_area(x, y, sw, sh);
+	for (int r = sy; r < (sy + sh); r++) {
+		if (flags & BITMAP_V2)
+			_lcd_bitmap_v2_row(btmp, height, r, sx, sw, row);
+		else
+			_lcd_bitmap_rle_row(btmp, &rle, width, sx, sw, row);
+		if (invert) {
+			for (uint8_t i = 0; i < sw; i++)
+				row[i] = ~row[i];
+		}
+		_lcd_write_data_block(row, sw);
+	}
 	_lcd_end_active_area();
 }
 
-
 /* ---
 #### void lcdBitmap(int x, int y, const uint8_t *bitmap, bool invert)
 
 Draw a bitmap. The color map may be inverted.
 
-The bitmap must be run-length-encoded using the `bitmap_gen.py` tool.
+The bitmap must be generated using the `bitmap_gen.py` tool; either a version 1 (run-length-encoded) or version 2 bitmap.
 The tool provides instructions on how to create a source graphic which will converted correctly.
+A version 2 bitmap is drawn with `lcdBitmapClip()` so it may be partially off the screen.
 
 **Notes:**
 Horizontal dimensions are in display triplets, not real pixels.
@@ -163,26 +332,155 @@ void lcdBitmap(int x, int y, const uint8_t *btmp, bool invert) {
 	int width, height, index = 0;
 	unsigned char length, value;
 
+	if (pgm_read_byte_near(btmp + 1) & BITMAP_V2) {
+		lcdBitmapClip(x, y, btmp, 0, 0, LCD_WIDTH, LCD_HEIGHT, invert);
+		return;
+	}
+
 	width = pgm_read_byte_near(btmp + index++) + (pgm_read_byte_near(btmp + index++) << 8);
 	height = pgm_read_byte_near(btmp + index++) + (pgm_read_byte_near(btmp + index++) << 8);
 
 	_lcd_set_active_area(x, y, TRIPLET_FROM_ACTUAL(width), height);
 
-	srxeDigitalWrite(LCD_CS, LOW);
+	// each run is streamed as a repeated byte; the CS is held for the whole bitmap
+	_lcd_stream_begin();
 	while ((length = pgm_read_byte_near(btmp + index++))) {
 		value = pgm_read_byte_near(btmp + index++);
 		if (invert)
 			value = ~value;
-		for (unsigned char count = 0; count < length; count++) {
-			_srxe_spi_transfer(value);
-			LCD_STREAM_GRABBER(value);
-		}
+		_lcd_stream_repeat(value, length);
 	}
-	srxeDigitalWrite(LCD_CS, HIGH);
+	_lcd_stream_end();
 
 	_lcd_end_active_area();
 }
 
+// the RAM used to stage data from the FLASH; even so the RLE pairs of a bitmap are never split between chunks
+#define _LCD_FLASH_CHUNK	64
+
+static uint32_t _lcd_flash_bytes, _lcd_flash_us;	// the last FLASH blit
+
+// copy `count` bytes from the FLASH to the current LCD window, one chunk at a time
+// the FLASH and the LCD share the SPI so each chunk is read and then sent; the CS of each device is only held for its own part
+static void _lcd_flash_stream(uint32_t addr, uint16_t count) {
+	uint8_t chunk[_LCD_FLASH_CHUNK];
+
+	while (count) {
+		uint8_t n = (count < _LCD_FLASH_CHUNK) ? count : _LCD_FLASH_CHUNK;
+		SRXEFlashRead(addr, chunk, n);
+		_lcd_write_data_block(chunk, n);
+		addr += n;
+		count -= n;
+	}
+}
+
+/* ---
+#### void lcdBlitFlash(int x, int y, int cx, int cy, uint32_t addr)
+
+Draw an uncompressed image stored at `addr` in the external FLASH.
+The image is `cy` rows of `cx` bytes _(triplets)_ in the same format the LCD uses; it has no header.
+
+The image is clipped to the screen; `x` and `y` may be negative or partially off the screen.
+Only 64 bytes of RAM are used regardless of the size of the image.
+
+**Notes:**
+Horizontal dimensions are in display triplets, not real pixels.
+Vertical dimensions are always in real pixels.
+--- */
+void lcdBlitFlash(int x, int y, int cx, int cy, uint32_t addr) {
+	if (!_lcd_init) return;
+
+	int sx = 0, sy = 0, sw = cx, sh = cy;
+	if (x < 0)					{ sx = -x; sw += x; x = 0; }
+	if (y < 0)					{ sy = -y; sh += y; y = 0; }
+	if ((x + sw) > LCD_WIDTH)	sw = LCD_WIDTH - x;
+	if ((y + sh) > LCD_HEIGHT)	sh = LCD_HEIGHT - y;
+
+	if ((sw <= 0) || (sh <= 0))
+		return;
+
+	uint32_t start = clockMicros();
+	_lcd_set_active_area(x, y, sw, sh);
+	addr += ((uint32_t)sy * cx) + sx;
+	if (sw == cx) {
+		// whole rows are one contiguous block of the FLASH
+		_lcd_flash_stream(addr, (uint16_t)sw * sh);
+	} else {
+		for (int r = 0; r < sh; r++, addr += cx)
+			_lcd_flash_stream(addr, sw);
+	}
+	_lcd_end_active_area();
+
+	_lcd_flash_us = clockMicros() - start;
+	_lcd_flash_bytes = (uint32_t)sw * sh;
+}
+
+/* ---
+#### bool lcdBitmapFlash(int x, int y, uint32_t addr, bool invert)
+
+Draw a version 1 _(run-length-encoded)_ bitmap stored at `addr` in the external FLASH. The color map may be inverted.
+
+The FLASH holds exactly the bytes which `bitmap_gen.py` generates for PROGMEM.
+Only 64 bytes of RAM are used regardless of the size of the bitmap.
+
+Returns `false` for a version 2 bitmap; they are not supported in FLASH.
+
+**Notes:**
+Horizontal dimensions are in display triplets, not real pixels.
+Vertical dimensions are always in real pixels.
+--- */
+bool lcdBitmapFlash(int x, int y, uint32_t addr, bool invert) {
+	if (!_lcd_init) return false;
+
+	uint8_t chunk[_LCD_FLASH_CHUNK];
+	SRXEFlashRead(addr, chunk, 4);
+	if (chunk[1] & BITMAP_V2)
+		return false;
+
+	int width = TRIPLET_FROM_ACTUAL(chunk[0] + (chunk[1] << 8));
+	int height = chunk[2] + (chunk[3] << 8);
+
+	uint32_t start = clockMicros();
+	_lcd_set_active_area(x, y, width, height);
+	addr += 4;	// the RLE data follows the width and height
+
+	bool done = false;
+	while (!done) {
+		// the last chunk may read past the end of the bitmap; the extra bytes are not used
+		SRXEFlashRead(addr, chunk, _LCD_FLASH_CHUNK);
+		addr += _LCD_FLASH_CHUNK;
+
+		_lcd_stream_begin();
+		for (uint8_t i = 0; i < _LCD_FLASH_CHUNK; i += 2) {
+			if (!chunk[i]) {
+				done = true;
+				break;
+			}
+			_lcd_stream_repeat(invert ? ~chunk[i + 1] : chunk[i + 1], chunk[i]);
+		}
+		_lcd_stream_end();
+	}
+	_lcd_end_active_area();
+
+	_lcd_flash_us = clockMicros() - start;
+	_lcd_flash_bytes = (uint32_t)width * height;
+	return true;
+}
+
+/* ---
+#### uint16_t lcdFlashRate()
+
+Returns the sustained rate of the last `lcdBlitFlash()` or `lcdBitmapFlash()` in KB/s of LCD data.
+
+Returns 0 if the clock is not running _(see `clockInit()`)_.
+--- */
+uint16_t lcdFlashRate() {
+	if (!_lcd_flash_us)
+		return 0;
+	// bytes * 1000000 / 1024 / us without overflow
+	return (uint16_t)((_lcd_flash_bytes * 15625UL) / (_lcd_flash_us * 16UL));
+}
+
 /* ---
 #### void lcdScrollSet(...)
 
@@ -210,7 +508,9 @@ void lcdScrollSet(int TA, int SA, int BA) {
 	_lcd_write_command(0x33); // set scroll area
 	_lcd_write_data_block(cmd_buffer, 3);
 
+	_lcd_scroll_top = (uint8_t)TA;
 	_lcd_scroll_area = (uint8_t)SA;
+	_lcd_page_height = 0;	// any page flip band is no longer valid
 }
 
 /* ---
@@ -225,9 +525,10 @@ void lcdScrollLines(int count) {
 	uint8_t b;
 
 	//  _lcd_scroll_offset = (_lcd_scroll_offset + iLines) % LCD_HEIGHT;
+	_lcd_page_height = 0;	// any page flip band is no longer valid
 	_lcd_scroll_offset = (_lcd_scroll_offset + count) % _lcd_scroll_area;
 	_lcd_write_command(0x37); // set scroll start line
-	b = (uint8_t)_lcd_scroll_offset;
+	b = (uint8_t)(_lcd_scroll_top + _lcd_scroll_offset);	// the start line is a driver line, not an offset within the scroll area
 	_lcd_write_data_block(&b, 1);
 } /* SRXEScroll() */
 
@@ -249,4 +550,74 @@ void lcdScrollReset(void) {
 	_lcd_write_data_block(&b, 1);
 } /* SRXEcdScrollReset() */
 
+/* ---
+#### bool lcdPageFlipBegin(int height)
+
+Start tear-free updates of a band at the bottom of the screen.
+The band is `height` pixel lines tall and covers rows `LCD_HEIGHT - height` to `LCD_HEIGHT - 1`.
+`height` may be from 1 to `LCD_HIDDEN_LINES` (24); returns `false` if it is out of range.
+
+The LCD driver has 160 lines but only 136 are visible. The band and the hidden lines below it form a scroll area with two pages.
+While page flipping is active, anything drawn entirely within the band goes to the page which is not visible.
+`lcdPageFlip()` then swaps the pages so a partially drawn band is never seen.
+
+|ROWS|BEHAVIOR|
+|:-----|:-----|
+|0 to `LCD_HEIGHT - height - 1`|normal; drawn directly to the screen|
+|`LCD_HEIGHT - height` to `LCD_HEIGHT - 1`|back buffered; a window must be entirely within the band|
+
+**Notes:**
+Each page keeps its own content; after a flip the new back page holds the band from two updates ago, so redraw the whole band each time.
+Drawing which crosses the top edge of the band goes directly to the band's own rows and is only seen when that page is visible.
+The page flip uses the scroll area; `lcdScrollSet()`, `lcdScrollLines()`, and `lcdScrollReset()` end it.
+--- */
+bool lcdPageFlipBegin(int height) {
+	if (!_lcd_init) return false;
+
+	if ((height < 1) || (height > LCD_HIDDEN_LINES))
+		return false;
+
+	uint8_t top = LCD_HEIGHT - height;
+	lcdScrollSet(top, height + LCD_HIDDEN_LINES, 0);
+	_lcd_scroll_offset = 0;
+	_lcd_write_command(0x37); // scroll start address
+	_lcd_write_data_block(&top, 1);
+
+	// the hidden lines have never been cleared
+	_lcd_set_active_area(0, LCD_HEIGHT, LCD_WIDTH, height);
+	_lcd_write_repeat(lcdColorTripletGetB(), (uint16_t)LCD_WIDTH * height);
+	_lcd_end_active_area();
+
+	_lcd_page_height = height;
+	_lcd_page_visible = 0;
+	return true;
+}
+
+/* ---
+#### void lcdPageFlip()
+
+Show the band which has been drawn since the last flip; the previously visible page becomes the one drawn on.
+--- */
+void lcdPageFlip() {
+	if (!_lcd_init) return;
+	if (!_lcd_page_height) return;
+
+	_lcd_page_visible ^= 1;
+	_lcd_scroll_offset = _lcd_page_visible ? _lcd_page_height : 0;
+	uint8_t b = _lcd_scroll_top + _lcd_scroll_offset;
+	_lcd_write_command(0x37); // scroll start address
+	_lcd_write_data_block(&b, 1);
+}
+
+/* ---
+#### void lcdPageFlipEnd()
+
+Stop page flipping and restore the default scroll area.
+The band shows its own rows again; if the hidden page was visible, redraw the band.
+--- */
+void lcdPageFlipEnd() {
+	if (!_lcd_page_height) return;
+	lcdScrollReset();
+}
+
 #endif // __SRXE_LCDDRAW_
@@ -0,0 +1,289 @@
+/* ************************************************************************************
+* File:	lcdshadow.h
+* Date:	2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+
+### LCD Shadow
+**Monochrome Shadow Buffer**
+
+The LCD can not be read back, so the direct draw functions can not combine with what is already on the screen.
+When `LCD_SHADOW` is defined, a 1 bit per pixel copy of the screen is kept in RAM _(6.5KB)_.
+The shadow functions draw into RAM with single pixel precision and may set, clear, or invert pixels _(eg: an XOR cursor)_.
+
+The changed part of each row is tracked in triplets and `lcdShadowFlush()` sends only the changed spans to the LCD.
+Set pixels are sent in the current foreground color and clear pixels in the current background color.
+
+The shadow only owns the spans it flushes. Greyscale content still comes from the direct draw functions;
+anything drawn directly over the shadow area is replaced on the next flush of those rows.
+Use `lcdShadowInvalidate()` to send an area again.
+
+**Notes:**
+Unlike the rest of the LCD functions, horizontal dimensions of the shadow functions are in real pixels, not display triplets.
+Vertical dimensions are always in real pixels.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_LCDSHADOW_
+#define __SRXE_LCDSHADOW_
+
+#ifdef LCD_SHADOW
+
+#include "common.h"
+#include "lcdbase.h"
+#include "lcdtext.h"
+
+#define LCD_SHADOW_ROW_BYTES	(LCD_WIDTH_ACTUAL / 8)
+
+// the drawing operations
+#define LCD_SHADOW_CLEAR	0
+#define LCD_SHADOW_SET		1
+#define LCD_SHADOW_XOR		2
+
+// the pixel bits of a row are stored with the low bit as the left most pixel (the same as the fonts)
+// one extra byte lets a triplet at the end of the last row be read 16 bits at a time
+static uint8_t _lcd_shadow[(LCD_SHADOW_ROW_BYTES * LCD_HEIGHT) + 1];
+
+// the changed triplets of each row; the end is exclusive so a row is clean when the end is not past the first
+static uint8_t _lcd_shadow_dirty_first[LCD_HEIGHT];
+static uint8_t _lcd_shadow_dirty_end[LCD_HEIGHT];
+
+// record a change to the pixels from x0 to x1 of a row
+static void _lcd_shadow_mark(uint8_t y, int x0, int x1) {
+	uint8_t t0 = TRIPLET_FROM_ACTUAL(x0);
+	uint8_t t1 = TRIPLET_FROM_ACTUAL(x1) + 1;
+
+	if (_lcd_shadow_dirty_end[y] <= _lcd_shadow_dirty_first[y]) {
+		_lcd_shadow_dirty_first[y] = t0;
+		_lcd_shadow_dirty_end[y] = t1;
+		return;
+	}
+	if (t0 < _lcd_shadow_dirty_first[y])
+		_lcd_shadow_dirty_first[y] = t0;
+	if (t1 > _lcd_shadow_dirty_end[y])
+		_lcd_shadow_dirty_end[y] = t1;
+}
+
+// apply an operation to the pixels from x0 to x1 of a row; the span must already be clipped
+static void _lcd_shadow_span(uint8_t y, int x0, int x1, uint8_t op) {
+	uint8_t *row = &_lcd_shadow[y * LCD_SHADOW_ROW_BYTES];
+	uint8_t b0 = x0 >> 3;
+	uint8_t b1 = x1 >> 3;
+
+	for (uint8_t b = b0; b <= b1; b++) {
+		uint8_t mask = 0xff;
+		if (b == b0)
+			mask &= (uint8_t)(0xff << (x0 & 0x7));
+		if (b == b1)
+			mask &= (uint8_t)(0xff >> (7 - (x1 & 0x7)));
+
+		if (op == LCD_SHADOW_SET)
+			row[b] |= mask;
+		else if (op == LCD_SHADOW_XOR)
+			row[b] ^= mask;
+		else
+			row[b] &= ~mask;
+	}
+	_lcd_shadow_mark(y, x0, x1);
+}
+
+// clip a horizontal span to the screen; returns false if nothing is left
+static bool _lcd_shadow_clip(int *x0, int *x1, int y) {
+	if ((y < 0) || (y >= LCD_HEIGHT))
+		return false;
+	if (*x0 < 0)
+		*x0 = 0;
+	if (*x1 > (LCD_WIDTH_ACTUAL - 1))
+		*x1 = LCD_WIDTH_ACTUAL - 1;
+	return (*x0 <= *x1);
+}
+
+
+/* ---
+#### void lcdShadowClear()
+
+Clear every pixel of the shadow; the whole screen is sent on the next flush.
+--- */
+void lcdShadowClear() {
+	memset(_lcd_shadow, 0, sizeof(_lcd_shadow));
+	memset(_lcd_shadow_dirty_first, 0, sizeof(_lcd_shadow_dirty_first));
+	memset(_lcd_shadow_dirty_end, LCD_WIDTH, sizeof(_lcd_shadow_dirty_end));
+}
+
+/* ---
+#### void lcdShadowInvalidate(int x, int y, int cx, int cy)
+
+Mark an area of the shadow as changed so it is sent on the next flush _(eg: after drawing directly over it)_.
+--- */
+void lcdShadowInvalidate(int x, int y, int cx, int cy) {
+	for (int r = y; r < (y + cy); r++) {
+		int x0 = x, x1 = x + cx - 1;
+		if (_lcd_shadow_clip(&x0, &x1, r))
+			_lcd_shadow_mark(r, x0, x1);
+	}
+}
+
+/* ---
+#### void lcdShadowPixel(int x, int y, uint8_t op)
+
+Set, clear, or invert a pixel; `op` is `LCD_SHADOW_SET`, `LCD_SHADOW_CLEAR`, or `LCD_SHADOW_XOR`.
+--- */
+void lcdShadowPixel(int x, int y, uint8_t op) {
+	int x1 = x;
+	if (_lcd_shadow_clip(&x, &x1, y))
+		_lcd_shadow_span(y, x, x1, op);
+}
+
+/* ---
+#### bool lcdShadowPixelGet(int x, int y)
+
+Returns `true` if the pixel is set in the shadow.
+--- */
+bool lcdShadowPixelGet(int x, int y) {
+	if ((x < 0) || (x >= LCD_WIDTH_ACTUAL) || (y < 0) || (y >= LCD_HEIGHT))
+		return false;
+	return (_lcd_shadow[(y * LCD_SHADOW_ROW_BYTES) + (x >> 3)] >> (x & 0x7)) & 0x1;
+}
+
+/* ---
+#### void lcdShadowHorizontalLine(int x, int y, int length, uint8_t op)
+
+Apply `op` to a horizontal line of pixels.
+--- */
+void lcdShadowHorizontalLine(int x, int y, int length, uint8_t op) {
+	int x1 = x + length - 1;
+	if (_lcd_shadow_clip(&x, &x1, y))
+		_lcd_shadow_span(y, x, x1, op);
+}
+
+/* ---
+#### void lcdShadowVerticalLine(int x, int y, int height, uint8_t op)
+
+Apply `op` to a vertical line of pixels.
+--- */
+void lcdShadowVerticalLine(int x, int y, int height, uint8_t op) {
+	for (int r = y; r < (y + height); r++)
+		lcdShadowPixel(x, r, op);
+}
+
+/* ---
+#### void lcdShadowRectangle(int x, int y, int cx, int cy, uint8_t mode, uint8_t op)
+
+Apply `op` to a rectangle; `mode` is `LCD_HOLLOW` or `LCD_FILLED`.
+--- */
+void lcdShadowRectangle(int x, int y, int cx, int cy, uint8_t mode, uint8_t op) {
+	if ((cx < 1) || (cy < 1))
+		return;
+
+	if (mode == LCD_HOLLOW) {
+		lcdShadowHorizontalLine(x, y, cx, op);
+		if (cy > 1)
+			lcdShadowHorizontalLine(x, y + cy - 1, cx, op);
+		if (cy > 2) {
+			lcdShadowVerticalLine(x, y + 1, cy - 2, op);
+			if (cx > 1)
+				lcdShadowVerticalLine(x + cx - 1, y + 1, cy - 2, op);
+		}
+		return;
+	}
+
+	for (int r = y; r < (y + cy); r++)
+		lcdShadowHorizontalLine(x, r, cx, op);
+}
+
+/* ---
+#### int lcdShadowPutString(const char* text, int x, int y, uint8_t op)
+
+Apply `op` to the pixels of the text using the current font; the pixels between the characters are not changed.
+Returns the horizontal position after the text.
+
+**Note:** fonts with `FONT_TRIPLETS` are not supported.
+--- */
+int lcdShadowPutString(const char *text, int x, int y, uint8_t op) {
+	FONTOBJECT *font = _lcd_font_get_pointer();
+	if (font->scale & FONT_TRIPLETS)
+		return x;
+
+	uint8_t mw = (font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1;
+	uint8_t mh = (font->scale & FONT_DOUBLE_HEIGHT) ? 2 : 1;
+
+	for (; *text; text++) {
+		if (x >= LCD_WIDTH_ACTUAL)
+			break;
+		// the font data character set starts at char(32)
+		const unsigned char *glyph = &(font->data[(*text - 32) * font->charbytes]);
+		for (uint8_t r = 0; r < font->height; r++) {
+			const unsigned char *src = glyph + (r * font->widthbytes);
+			uint8_t bits = 0;
+			for (uint8_t i = 0; i < font->width; i++) {
+				if (!(i & 0x7))
+					bits = pgm_read_byte(src++);
+				if (bits & 0x1) {
+					for (uint8_t m = 0; m < mh; m++) {
+						int x0 = x + (i * mw), x1 = x0 + mw - 1;
+						if (_lcd_shadow_clip(&x0, &x1, y + (r * mh) + m))
+							_lcd_shadow_span(y + (r * mh) + m, x0, x1, op);
+					}
+				}
+				bits >>= 1;
+			}
+		}
+		x += font->width * mw;
+	}
+	return x;
+}
+
+/* ---
+#### void lcdShadowFlush()
+
+Send the changed spans of the shadow to the LCD using the current foreground and background colors.
+Consecutive rows with the same span share one LCD window.
+--- */
+void lcdShadowFlush() {
+	if (!_lcd_init) return;
+
+	uint8_t buffer[LCD_WIDTH];
+
+	_lcd_text_lut_set(lcdColorTripletGetF() & 0x3, lcdColorTripletGetB() & 0x3);
+
+	uint8_t y = 0;
+	while (y < LCD_HEIGHT) {
+		uint8_t first = _lcd_shadow_dirty_first[y];
+		uint8_t end = _lcd_shadow_dirty_end[y];
+		if (end <= first) {
+			y++;
+			continue;
+		}
+
+		// extend the window over the following rows with the same span
+		uint8_t rows = 1;
+		while (((y + rows) < LCD_HEIGHT) && (_lcd_shadow_dirty_first[y + rows] == first) && (_lcd_shadow_dirty_end[y + rows] == end))
+			rows++;
+
+		uint8_t count = end - first;
+		_lcd_set_active_area(first, y, count, rows);
+		for (uint8_t r = 0; r < rows; r++, y++) {
+			const uint8_t *row = &_lcd_shadow[y * LCD_SHADOW_ROW_BYTES];
+			uint16_t p = TRIPLET_TO_ACTUAL(first);
+			for (uint8_t t = 0; t < count; t++, p += TRIPLET_SIZE) {
+				uint16_t bits = row[p >> 3] | (row[(p >> 3) + 1] << 8);
+				buffer[t] = _lcd_text_lut[(bits >> (p & 0x7)) & 0x7];
+			}
+			_lcd_write_data_block(buffer, count);
+
+			// mark the row clean
+			_lcd_shadow_dirty_first[y] = 0;
+			_lcd_shadow_dirty_end[y] = 0;
+		}
+		_lcd_end_active_area();
+	}
+}
+
+#endif // LCD_SHADOW
+#endif // __SRXE_LCDSHADOW_
@@ -49,9 +49,14 @@ The input parameters are:
 - uint8_t char_bytes - defined in the font `.h` file
 - uint8_t scale - `FONT_DEFAULT_SCALE`, `FONT_DOUBLE_WIDTH`, `FONT_DOUBLE_HEIGHT`, or `FONT_DOUBLED`
 
+Add `FONT_TRIPLETS` to the scale when the data was generated with `font_gen.py --triplets`.
+Triplet fonts are drawn straight from PROGMEM with the colors applied to each byte; they use more FLASH but draw faster.
+A triplet font may be doubled in height but not in width _(`FONT_DOUBLE_WIDTH` is ignored)_.
+
 **Notes:
 Font dimension parameters are in real pixels, not display triplets.
 Vertical dimensions are always in real pixels.
+For a triplet font, the `width_bytes` and `char_bytes` are the triplets of a row and of a character, as defined in the font `.h` file.
 --- */
 void lcdFontConfig(uint8_t id, const unsigned char* data, uint8_t width, uint8_t height, uint8_t width_bytes, uint8_t char_bytes, uint8_t scale) {
 	// initialize a font
@@ -63,6 +68,8 @@ void lcdFontConfig(uint8_t id, const unsigned char* data, uint8_t width, uint8_t
 	_srxe_fonts[id].height = height;
 	_srxe_fonts[id].widthbytes = width_bytes;
 	_srxe_fonts[id].charbytes = char_bytes;
+	if (scale & FONT_TRIPLETS)
+		scale &= ~FONT_DOUBLE_WIDTH;	// the packed triplets can not be widened
 	_srxe_fonts[id].scale = scale;
 }
 
@@ -90,6 +97,8 @@ void lcdFontClone(uint8_t target_id, uint8_t source_id, uint8_t scale) {
 		return;
 
 	memcpy((void*)&(_srxe_fonts[target_id]), (void*)&(_srxe_fonts[source_id]), sizeof(FONTOBJECT));
+	if (_srxe_fonts[source_id].scale & FONT_TRIPLETS)
+		scale = (scale | FONT_TRIPLETS) & ~FONT_DOUBLE_WIDTH;	// the clone shares the data so it keeps the format
 	_srxe_fonts[target_id].scale = scale;
 }
 
@@ -163,166 +172,194 @@ uint16_t lcdTextWidthGet(const char *text) {
 
 
 
-/* ---
-#### int lcdPutChar(char c)
+// the widest character cell (in triplets) the text renderer supports; this is a 24 pixel font at double width
+#define _LCD_TEXT_MAX_CELL	16
 
-Display a character at the current LCD position, using the current font, and colors.
+// Text is expanded with a table of the 8 possible 3 pixel groups in the current text colors
+// the index bits are font pixels (the low bit is the left most pixel) and the value is the triplet with LCD_CORRECT_COLOR applied
+static uint8_t _lcd_text_lut[8];
+static uint8_t _lcd_text_lut_colors = 0xff;	// the fg and bg the table was built for
+static uint8_t _lcd_text_fg3, _lcd_text_bg3;	// the colors repeated for all three pixels of a triplet; used with FONT_TRIPLETS
 
-Return -1 if the character was not displayed, otherwise it returns the width of the character displayed.
+// every bit of a nibble doubled; used to expand FONT_DOUBLE_WIDTH glyph rows
+static const uint8_t _lcd_double_bits[16] PROGMEM = {
+	0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f,
+	0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff};
 
-Use `lcdPositionSet()`, `lcdFontSet()`, and `lcdColorSet()` as necessary, prior to using the function.
+// (re)build the text table when the colors change
+static void _lcd_text_lut_set(uint8_t fg, uint8_t bg) {
+	uint8_t colors = (fg << 2) | bg;
 
-The current position is updated by this function.
---- */
-int lcdPutChar(char c) {
-	// The initial location, font, and color(s) must already be set before using this function
-	// eg: lcdPositionSet(x, y); lcdColorSet(fg, bg); lcdFontSet(id);
+	if (colors == _lcd_text_lut_colors)
+		return;
+
+	for (uint8_t i = 0; i < 8; i++) {
+		// pixels are packed bbxbbxbb with the first pixel in the high bits
+		uint8_t triplet = (((i & 0x1) ? fg : bg) << 6) | (((i & 0x2) ? fg : bg) << 3) | ((i & 0x4) ? fg : bg);
+		_lcd_text_lut[i] = LCD_CORRECT_COLOR(triplet);
+	}
+	_lcd_text_fg3 = (fg << 6) | (fg << 3) | fg;
+	_lcd_text_bg3 = (bg << 6) | (bg << 3) | bg;
+	_lcd_text_lut_colors = colors;
+}
 
+// Expand one row of a glyph into `cell` triplets using the text table
+// src is the row of font data in PROGMEM; the pixel bits are stored mirrored (the low bit is the left most pixel)
+// the row is padded with background to the triplet boundary; with a padding of 2 one pixel goes before and one after the glyph
+// returns the pointer past the last triplet written
+static uint8_t *_lcd_glyph_row(uint8_t *bp, const unsigned char *src, uint8_t width, uint8_t multiplier, uint8_t padding, uint8_t cell) {
+	uint8_t b;
+
+	// the common case: the whole row is one byte (eg: the 6 and 8 pixel wide fonts) and is used 3 pixels at a time
+	if ((multiplier == 1) && (width <= 8)) {
+		uint16_t row = pgm_read_byte(src) & ((1 << width) - 1);
+		if (padding == 2)
+			row <<= 1;	// one background pixel before the glyph
+		while (cell--) {
+			*bp++ = _lcd_text_lut[row & 0x7];
+			row >>= TRIPLET_SIZE;
+		}
+		return bp;
+	}
+
+	// the pixels are queued in a bit accumulator and taken 3 at a time; a background pixel is a 0 bit
+	uint8_t *end = bp + cell;
+	uint16_t bits = 0;
+	uint8_t count = (padding == 2) ? 1 : 0;	// pixels in the accumulator
+	uint8_t remaining = width;				// font pixels not yet read
+	uint8_t pending = 0, has_pending = 0;	// the doubled high nibble of the last font byte
+
+	while (bp < end) {
+		if (count < TRIPLET_SIZE) {
+			// add the next 8 pixels; after the end of the glyph they are all background
+			if (has_pending) {
+				b = pending;
+				has_pending = 0;
+			} else if (remaining) {
+				b = pgm_read_byte(src++);
+				if (remaining < 8) {
+					b &= (1 << remaining) - 1;	// discard the unused bits of the last byte
+					remaining = 0;
+				} else {
+					remaining -= 8;
+				}
+				if (multiplier > 1) {
+					pending = pgm_read_byte(&_lcd_double_bits[b >> 4]);
+					has_pending = 1;
+					b = pgm_read_byte(&_lcd_double_bits[b & 0xf]);
+				}
+			} else {
+				b = 0;
+			}
+			bits |= ((uint16_t)b) << count;
+			count += 8;
+		}
+		*bp++ = _lcd_text_lut[bits & 0x7];
+		bits >>= TRIPLET_SIZE;
+		count -= TRIPLET_SIZE;
+	}
+	return bp;
+}
+
+// Compose pixel row `r` of the glyphs of `count` characters using the text colors set with _lcd_text_lut_set()
+// each character is one cell of triplets; returns the pointer past the last triplet written
+static uint8_t *_lcd_text_row(uint8_t *bp, const char *text, uint16_t count, FONTOBJECT *font, uint8_t r) {
+	uint8_t font_multiplier_width = ((font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1);
+	uint8_t glyph_width = font->width * font_multiplier_width;
+	uint8_t padding = TRIPLET_OFFSET(glyph_width);
+	uint8_t cell = TRIPLET_FROM_ACTUAL(glyph_width + padding);
+	const unsigned char *src;
+
+	for (uint16_t i = 0; i < count; i++) {
+		// the font data character set starts at char(32)
+		src = &(font->data[((text[i] - 32) * font->charbytes) + (r * font->widthbytes)]);
+		if (font->scale & FONT_TRIPLETS) {
+			// a mask bit pair of 11 selects the foreground
+			for (uint8_t t = 0; t < cell; t++) {
+				uint8_t mask = pgm_read_byte(src++);
+				uint8_t triplet = (_lcd_text_fg3 & mask) | (_lcd_text_bg3 & ~mask);
+				*bp++ = LCD_CORRECT_COLOR(triplet);
+			}
+		} else {
+			bp = _lcd_glyph_row(bp, src, font->width, font_multiplier_width, padding, cell);
+		}
+	}
+	return bp;
+}
+
+// Draw `count` characters at the current position, using the current font and colors, through a single window
+// each pixel row of the whole run is composed and sent in turn; a doubled height row is sent twice
+// characters past LCD_WIDTH are clipped (the last character may be partially drawn)
+// returns the new horizontal position or -1 if nothing was drawn
+static int _lcd_put_text(const char *text, uint16_t count) {
 	int x = lcdPositionGetX();
 	int y = lcdPositionGetY();
 
 	uint8_t fg = lcdColorTripletGetF() & 0x3;
 	uint8_t bg = lcdColorTripletGetB() & 0x3;
 
-	if (fg > 3) fg = 3;
-	if (bg > 3) bg = 3;
-
 	FONTOBJECT *font = _lcd_font_get_pointer();
 
-	uint8_t font_width = font->width;
 	uint8_t font_multiplier_width = ((font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1);
-	uint8_t glyph_width = font_width * font_multiplier_width;
-	uint8_t font_height = font->height;
 	uint8_t font_multiplier_height = ((font->scale & FONT_DOUBLE_HEIGHT) ? 2 : 1);
-	uint8_t glyph_height = font_height * font_multiplier_height;
-	uint8_t font_widthbytes = font->widthbytes;
-	uint8_t font_charbytes = font->charbytes;
-
-	// NOTE: padding will be 0, 1, or 2; if it is 2, then we split the padding before and after the glyph
-	uint8_t padding = TRIPLET_OFFSET(glyph_width);	// this is the number of pixels to get to the next triplet boundary
+	uint8_t glyph_width = font->width * font_multiplier_width;
+	uint8_t padding = TRIPLET_OFFSET(glyph_width);
+	uint8_t cell = TRIPLET_FROM_ACTUAL(glyph_width + padding);	// triplets per character
 
-	// if the character will not fit, then we error out
-	if ((glyph_width + TRIPLET_TO_ACTUAL(x)) > LCD_WIDTH_ACTUAL)
+	if (!count || !cell || (cell > _LCD_TEXT_MAX_CELL) || (x >= LCD_WIDTH))
 		return -1;
 
-	// NOTE:    font data is width (bits) first by height (bits)
-	//          the pixel bits are stored mirrored (the low bit is the left most pixel)
-	// WARNING: font width must be a multiple of 3 ... well, actually we pad the end with background color
-
-	// the code used a LCD bitmap buffer and pointer (bp), as well as a character bitmap buffer and pointer (cp)
-	// the font is 1-bit per pixel aka 8 pixels per byte and the LCD screen is 3 pixels per byte (3bits-3bits-2bits) - the code calls this a 'triplet'
-
-	// BUG there is some problem with FONT4
-
-	uint16_t lcd_bitmap_size = TRIPLET_FROM_ACTUAL(glyph_width + padding) * glyph_height;
-	uint8_t lcd_bitmap[lcd_bitmap_size], *bp, bp_counter;									// lcd bitmap and pointer
-	uint8_t font_bytes[font_charbytes], *cp, cb, cb_multiplier_width, cb_multiplier_height; // font character buffer and pointer and current byte
-	uint8_t triplet;
-	uint8_t pixel; // this is the index of the current pixel; we used to use the 'k' loop variable but now we might already have a pixels before the loop starts
-
-	bp = lcd_bitmap;
-	bp_counter = 0;
-	cb_multiplier_width = cb_multiplier_height = 1;
-
-	// the font data character set starts at char(32) so we subtract that value from the byte code
-	// get pointer to the character's pixel bytes in PROGMEM
-	cp = (unsigned char *)&(font->data[(c - 32) * (font_charbytes)]);
-	memcpy_P(font_bytes, cp, font_charbytes); // then copy from PROGMEM to local buffer
-	cp = font_bytes;						  // then update the pointer to the local buffer
-	cb = cp[0];
-
-	// process each byte of pixels of the character
-	for (int j = 0; j < font_charbytes;) {
-		triplet = bg;
-		pixel = 0;
-
-		if (padding == 2) { // when padding == 2 we put one pixel before and one pixel after
-			// shift the output byte left 3 to make room for the next pixel
-			triplet <<= 3;
-			// clear low 3 bits
-			triplet &= 0b11111000;
-			triplet |= bg;
-			pixel++;
-		}
+	// clip the run at the right edge of the screen
+	uint16_t span = count * cell;
+	if (span > (uint16_t)(LCD_WIDTH - x)) {
+		span = LCD_WIDTH - x;
+		count = (span + cell - 1) / cell;	// include a partially visible character
+	}
 
-		// process a single row of the font character bitmap
-		for (int k = 0; k < (font_width * font_multiplier_width); k++) {
-
-			// after every 3 pixels, we need to start the next triplet
-			if (pixel && !(pixel % TRIPLET_SIZE)) {
-				// WTF - try cleaning up the triplet
-				triplet = LCD_CORRECT_COLOR(triplet);
-				*bp = triplet;
-				bp++;
-				triplet = bg;
-				bp_counter++;
-				if (bp_counter >= lcd_bitmap_size) {
-					return -1;
-				}
-			}
+	// the row has room for the part of the last character which is clipped
+	uint8_t row[LCD_WIDTH + _LCD_TEXT_MAX_CELL];
 
-			// do we need to get the next pixel byte from the input
-			// if its not the (very beginning) and (if either (we have process 8 pixel bits) or (we have reach the end of a row of the font))
-			if (k && !(k % (8 * font_multiplier_width))) {
-				j++;
-				cb = cp[j];
-			}
+	_lcd_text_lut_set(fg, bg);
 
-			// shift the output byte left 3 to make room for the next pixel
-			triplet <<= TRIPLET_SIZE;
-			// clear low 3 bits
-			triplet &= 0b11111000;
+	_lcd_set_active_area(x, y, span, font->height * font_multiplier_height);
+	for (uint8_t r = 0; r < font->height; r++) {
+		_lcd_text_row(row, text, count, font, r);
+		for (uint8_t m = 0; m < font_multiplier_height; m++)
+			_lcd_write_data_block(row, span);
+	}
+	_lcd_end_active_area();
 
-			// if the low pixel bit is 1, then we set the low two bits of the bitmap byte to fg
-			triplet |= (cb & 0x1) ? fg : bg;
-			pixel++;
+	// update position
+	x += span;
+	lcdPositionSet(x, y);
 
-			// if wer are multiplying the width, then we repeat the same pixel
-			if (cb_multiplier_width < font_multiplier_width) {
-				cb_multiplier_width++;	// repeat the same pixel
-			} else {
-				cb_multiplier_width = 1;
-				cb = cb >> 1; 			// discard the used pixel bit
-			}
-		} // end of for loop of one row of pixels pixels from the character bitmap data
-
-		// pad out the end of the triplet
-		if (padding) {
-			// shift the output byte left 3 to make room for the next pixel
-			triplet <<= 3;
-			// clear low 3 bits
-			triplet &= 0b11111000;
-			triplet |= bg;
-		}
-		// WTF - try cleaning up the triplet
-		triplet = LCD_CORRECT_COLOR(triplet);
-		*bp = triplet;
-		bp++;
-		bp_counter++;
-		// throw away any remaining bits and start with a new byte from the source pixels
-		j++;
-
-		if (cb_multiplier_height < font_multiplier_height) {
-			cb_multiplier_height++;
-			j -= font_widthbytes;
-		} else {
-			cb_multiplier_height = 1;
-		}
+	return x;
+}
 
-		cb = cp[j];
 
-	} // end of for loop of character bitmap data
+/* ---
+#### int lcdPutChar(char c)
 
-	// assuming we did everything correctly, the bitmap is now loaded up
-	_lcd_set_active_area(x, y, TRIPLET_FROM_ACTUAL(glyph_width + padding), glyph_height);
-	_lcd_write_data_block(lcd_bitmap, lcd_bitmap_size); // write character pattern
-	_lcd_end_active_area();
+Display a character at the current LCD position, using the current font, and colors.
 
-	// update position
-	x += TRIPLET_FROM_ACTUAL(glyph_width + padding);
-	lcdPositionSet(x, y);
+Return -1 if the character was not displayed, otherwise it returns the width of the character displayed.
 
-	return x;
+Use `lcdPositionSet()`, `lcdFontSet()`, and `lcdColorSet()` as necessary, prior to using the function.
+
+The current position is updated by this function.
+--- */
+int lcdPutChar(char c) {
+	// The initial location, font, and color(s) must already be set before using this function
+	// eg: lcdPositionSet(x, y); lcdColorSet(fg, bg); lcdFontSet(id);
+
+	FONTOBJECT *font = _lcd_font_get_pointer();
+	uint8_t glyph_width = font->width * ((font->scale & FONT_DOUBLE_WIDTH) ? 2 : 1);
+
+	// if the character will not fit, then we error out
+	if ((glyph_width + TRIPLET_TO_ACTUAL(lcdPositionGetX())) > LCD_WIDTH_ACTUAL)
+		return -1;
+
+	return _lcd_put_text(&c, 1);
 }
 
 
@@ -331,7 +368,9 @@ int lcdPutChar(char c) {
 
 Display a string at the current LCD position, using the current font, and colors.
 
-Return -1 if the character was not displayed, otherwise it returns the width of the string displayed.
+Return -1 if the string was not displayed, otherwise it returns the new horizontal position.
+
+The whole string is drawn through a single LCD window. Text which extends past the right edge of the screen is clipped.
 
 Use `lcdPositionSet()`, `lcdFontSet()`, and `lcdColorSet()` as necessary, prior to using the function.
 
@@ -341,17 +380,7 @@ int lcdPutString(const char *message) //small font 576 bytes
 {
 	if (!_lcd_init) return -1;
 
-	int w, width = 0;
-	int text_len = strlen(message);
-
-	for (int i = 0; i < text_len; i++) {
-		w = lcdPutChar(message[i]);
-		if (w < 0)
-			break;
-		width += w;
-	}
-
-	return w;
+	return _lcd_put_text(message, strlen(message));
 }
 
 /* ---
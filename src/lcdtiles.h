@@ -0,0 +1,375 @@
+/* ************************************************************************************
+* File:	lcdtiles.h
+* Date:	2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+
+### LCD Tiles
+**Tile Maps and Sprites**
+
+Games and animated displays which redraw every bitmap for every frame spend most of their time sending pixels which have not changed.
+When `LCD_TILES` is defined, an area of the screen may be drawn as a grid of cells from a tile map.
+The tile drawn in each cell is remembered and a render only sends the cells whose tile has changed.
+Changed cells which are next to each other on a row share one LCD window.
+
+The tile set is an array of uncompressed tiles, all of the same size, in PROGMEM or in the external FLASH.
+Each tile is `cy` rows of `cx` bytes _(triplets)_ in the same format the LCD uses. Tile `n` starts at `n * cx * cy`.
+
+The map is an array of tile numbers in RAM, one byte per cell, row by row. It may be larger than the area;
+the view selects the map cell shown in the top left cell of the area and the map wraps in both directions.
+Moving the view one column scrolls the map by one tile.
+A cell with the tile `LCD_TILE_NONE` is drawn with the current background color.
+
+Sprites are tiles drawn over the map at any position within the area. Pixels of a sprite which match the sprite key color are transparent.
+Only the cells under the old and new positions of a sprite which has changed are sent.
+
+The area holds up to `LCD_TILES_CELLS` _(default 512)_ cells; one byte of RAM each.
+There are `LCD_TILES_SPRITES` _(default 8)_ sprites.
+
+A typical use:
+```C
+lcdTilesSetP(game_tiles, 4, 8);			// 4 triplets (12 pixels) by 8 pixels
+lcdTilesBegin(0, 0, 32, 16);			// the full width of the screen
+lcdTilesMap(level, 128, 16);
+while (playing) {
+	lcdTilesView(scroll++, 0);
+	lcdTilesSprite(0, player_x, player_y, TILE_PLAYER);
+	lcdTilesRender();
+}
+```
+
+**Notes:**
+The tile numbers `0xFE` and `0xFF` are reserved; a tile set has at most 254 tiles.
+Anything drawn directly over the area is replaced only when the cells are sent again; use `lcdTilesInvalidate()` to send every cell on the next render.
+Horizontal dimensions are in display triplets, not real pixels.
+Vertical dimensions are always in real pixels.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_LCDTILES_
+#define __SRXE_LCDTILES_
+
+#ifdef LCD_TILES
+
+#include "common.h"
+#include "flash.h"
+#include "lcdbase.h"
+#include "lcddraw.h"
+
+#ifndef LCD_TILES_CELLS
+#define LCD_TILES_CELLS 512
+#endif
+
+#ifndef LCD_TILES_SPRITES
+#define LCD_TILES_SPRITES 8
+#endif
+
+#define LCD_TILE_NONE		0xFF	// an empty cell or a hidden sprite
+#define LCD_TILE_OPAQUE		0xFF	// a sprite key color which makes every pixel of the sprites visible
+#define _LCD_TILES_DIRTY	0xFE	// a cell which must be sent on the next render
+#define _LCD_TILES_MAX_CX	32		// the widest tile, in triplets
+
+typedef struct {
+	int x, y;					// the position within the area
+	uint8_t tile;
+	int drawn_x, drawn_y;		// the position and tile at the last render
+	uint8_t drawn_tile;
+} _LCD_TILES_SPRITE;
+
+static const uint8_t *_lcd_tiles_data;
+static uint32_t _lcd_tiles_addr;
+static bool _lcd_tiles_flash;
+static uint8_t _lcd_tiles_cx, _lcd_tiles_cy;
+
+static uint8_t _lcd_tiles_x, _lcd_tiles_y, _lcd_tiles_cols, _lcd_tiles_rows;	// the area
+
+static const uint8_t *_lcd_tiles_map;
+static uint8_t _lcd_tiles_map_cols, _lcd_tiles_map_rows;
+static uint8_t _lcd_tiles_view_col, _lcd_tiles_view_row;
+
+static uint8_t _lcd_tiles_drawn[LCD_TILES_CELLS];	// the tile last sent to each cell of the area
+static _LCD_TILES_SPRITE _lcd_tiles_sprites[LCD_TILES_SPRITES];
+static uint8_t _lcd_tiles_key = LCD_TILE_OPAQUE;
+static uint8_t _lcd_tiles_bg;
+
+// read one row of a tile; an empty cell is the background color
+static void _lcd_tiles_line(uint8_t tile, uint8_t line, uint8_t *out) {
+	if (tile >= _LCD_TILES_DIRTY) {
+		memset(out, _lcd_tiles_bg, _lcd_tiles_cx);
+		return;
+	}
+	uint16_t offset = (((uint16_t)tile * _lcd_tiles_cy) + line) * _lcd_tiles_cx;
+	if (_lcd_tiles_flash)
+		SRXEFlashRead(_lcd_tiles_addr + offset, out, _lcd_tiles_cx);
+	else
+		memcpy_P(out, _lcd_tiles_data + offset, _lcd_tiles_cx);
+}
+
+// the tile of a cell of the area using the view; the map wraps in both directions
+static uint8_t _lcd_tiles_cell(uint8_t col, uint8_t row) {
+	if (!_lcd_tiles_map)
+		return LCD_TILE_NONE;
+	uint16_t c = (_lcd_tiles_view_col + col) % _lcd_tiles_map_cols;
+	uint16_t r = (_lcd_tiles_view_row + row) % _lcd_tiles_map_rows;
+	return _lcd_tiles_map[(r * _lcd_tiles_map_cols) + c];
+}
+
+// mark the cells under a sprite so they are sent on the next render
+static void _lcd_tiles_mark(int x, int y) {
+	int c0 = (x < 0) ? 0 : (x / _lcd_tiles_cx);
+	int r0 = (y < 0) ? 0 : (y / _lcd_tiles_cy);
+	int c1 = (x + _lcd_tiles_cx - 1) / _lcd_tiles_cx;
+	int r1 = (y + _lcd_tiles_cy - 1) / _lcd_tiles_cy;
+
+	if ((c1 < 0) || (r1 < 0))
+		return;
+	if (c1 >= _lcd_tiles_cols)	c1 = _lcd_tiles_cols - 1;
+	if (r1 >= _lcd_tiles_rows)	r1 = _lcd_tiles_rows - 1;
+
+	for (int r = r0; r <= r1; r++)
+		for (int c = c0; c <= c1; c++)
+			_lcd_tiles_drawn[(r * _lcd_tiles_cols) + c] = _LCD_TILES_DIRTY;
+}
+
+// draw the part of a sprite which is on one line of the area between x0 and x0 + count
+static void _lcd_tiles_sprite_line(_LCD_TILES_SPRITE *sprite, int y, int x0, uint8_t count, uint8_t *out) {
+	if (sprite->tile >= _LCD_TILES_DIRTY)
+		return;
+	int line = y - sprite->y;
+	if ((line < 0) || (line >= _lcd_tiles_cy))
+		return;
+	int a = (sprite->x > x0) ? sprite->x : x0;
+	int b = ((sprite->x + _lcd_tiles_cx) < (x0 + count)) ? (sprite->x + _lcd_tiles_cx) : (x0 + count);
+	if (a >= b)
+		return;
+
+	uint8_t src[_LCD_TILES_MAX_CX];
+	_lcd_tiles_line(sprite->tile, line, src);
+
+	if (_lcd_tiles_key == LCD_TILE_OPAQUE) {
+		memcpy(&out[a - x0], &src[a - sprite->x], b - a);
+		return;
+	}
+
+	// each of the three pixels of a triplet is transparent when it matches the key color
+	uint8_t key = _lcd_color_to_byte[_lcd_tiles_key];
+	for (int x = a; x < b; x++) {
+		uint8_t s = src[x - sprite->x];
+		uint8_t *d = &out[x - x0];
+		if ((s ^ key) & 0b11100000)	*d = (*d & 0b00011111) | (s & 0b11100000);
+		if ((s ^ key) & 0b00011100)	*d = (*d & 0b11100011) | (s & 0b00011100);
+		if ((s ^ key) & 0b00000011)	*d = (*d & 0b11111100) | (s & 0b00000011);
+	}
+}
+
+// send the cells from c0 to c1 of a row of the area through one window
+static void _lcd_tiles_run(uint8_t row, uint8_t c0, uint8_t c1) {
+	uint8_t buffer[LCD_WIDTH];
+	uint8_t count = (c1 - c0 + 1) * _lcd_tiles_cx;
+	int x0 = c0 * _lcd_tiles_cx;
+	int y0 = row * _lcd_tiles_cy;
+
+	_lcd_set_active_area(_lcd_tiles_x + x0, _lcd_tiles_y + y0, count, _lcd_tiles_cy);
+	for (uint8_t line = 0; line < _lcd_tiles_cy; line++) {
+		for (uint8_t c = c0; c <= c1; c++)
+			_lcd_tiles_line(_lcd_tiles_drawn[(row * _lcd_tiles_cols) + c], line, &buffer[(c - c0) * _lcd_tiles_cx]);
+		for (uint8_t s = 0; s < LCD_TILES_SPRITES; s++)
+			_lcd_tiles_sprite_line(&_lcd_tiles_sprites[s], y0 + line, x0, count, buffer);
+		_lcd_write_data_block(buffer, count);
+	}
+	_lcd_end_active_area();
+}
+
+
+/* ---
+#### bool lcdTilesSetP(const uint8_t *tiles, uint8_t cx, uint8_t cy)
+
+Use a tile set in PROGMEM. Each tile is `cx` triplets wide _(at most 32)_ and `cy` pixels high.
+The area must then be placed again with `lcdTilesBegin()`.
+
+Returns `false` if the tile size is not supported.
+--- */
+bool lcdTilesSetP(const uint8_t *tiles, uint8_t cx, uint8_t cy) {
+	if ((cx < 1) || (cx > _LCD_TILES_MAX_CX) || (cy < 1))
+		return false;
+	_lcd_tiles_data = tiles;
+	_lcd_tiles_flash = false;
+	_lcd_tiles_cx = cx;
+	_lcd_tiles_cy = cy;
+	_lcd_tiles_cols = 0;	// the area must be set again
+	return true;
+}
+
+/* ---
+#### bool lcdTilesSetFlash(uint32_t addr, uint8_t cx, uint8_t cy)
+
+Use a tile set stored at `addr` in the external FLASH; otherwise the same as `lcdTilesSetP()`.
+
+**Note:** each row of a tile is a separate FLASH read; a tile set in PROGMEM is faster.
+--- */
+bool lcdTilesSetFlash(uint32_t addr, uint8_t cx, uint8_t cy) {
+	if (!lcdTilesSetP(NULL, cx, cy))
+		return false;
+	_lcd_tiles_addr = addr;
+	_lcd_tiles_flash = true;
+	return true;
+}
+
+/* ---
+#### bool lcdTilesBegin(int x, int y, uint8_t cols, uint8_t rows)
+
+Place the tile area on the screen with its top left corner at `x`, `y` and a size of `cols` by `rows` cells.
+All sprites are hidden and every cell is sent on the next render.
+
+Returns `false` if there is no tile set, the area does not fit on the screen, or it has more than `LCD_TILES_CELLS` cells.
+--- */
+bool lcdTilesBegin(int x, int y, uint8_t cols, uint8_t rows) {
+	_lcd_tiles_cols = 0;
+	if (!_lcd_tiles_cx || !cols || !rows || (x < 0) || (y < 0))
+		return false;
+	if (((uint16_t)cols * rows) > LCD_TILES_CELLS)
+		return false;
+	if (((x + (cols * _lcd_tiles_cx)) > LCD_WIDTH) || ((y + (rows * _lcd_tiles_cy)) > LCD_HEIGHT))
+		return false;
+
+	_lcd_tiles_x = x;
+	_lcd_tiles_y = y;
+	_lcd_tiles_cols = cols;
+	_lcd_tiles_rows = rows;
+
+	for (uint8_t s = 0; s < LCD_TILES_SPRITES; s++) {
+		_lcd_tiles_sprites[s].tile = LCD_TILE_NONE;
+		_lcd_tiles_sprites[s].drawn_tile = LCD_TILE_NONE;
+	}
+	memset(_lcd_tiles_drawn, _LCD_TILES_DIRTY, sizeof(_lcd_tiles_drawn));
+	return true;
+}
+
+/* ---
+#### void lcdTilesMap(const uint8_t *map, uint8_t cols, uint8_t rows)
+
+Use a map of `cols` by `rows` tile numbers in RAM. The view is moved back to the top left of the map.
+
+The map is read on every render; changing a cell of the map changes the screen on the next render.
+--- */
+void lcdTilesMap(const uint8_t *map, uint8_t cols, uint8_t rows) {
+	if (!cols || !rows)
+		map = NULL;
+	_lcd_tiles_map = map;
+	_lcd_tiles_map_cols = cols;
+	_lcd_tiles_map_rows = rows;
+	_lcd_tiles_view_col = 0;
+	_lcd_tiles_view_row = 0;
+}
+
+/* ---
+#### void lcdTilesView(int col, int row)
+
+Show the map cell at `col`, `row` in the top left cell of the area. The map wraps in both directions.
+--- */
+void lcdTilesView(int col, int row) {
+	if (!_lcd_tiles_map)
+		return;
+	col %= _lcd_tiles_map_cols;
+	row %= _lcd_tiles_map_rows;
+	_lcd_tiles_view_col = (col < 0) ? (col + _lcd_tiles_map_cols) : col;
+	_lcd_tiles_view_row = (row < 0) ? (row + _lcd_tiles_map_rows) : row;
+}
+
+/* ---
+#### void lcdTilesSprite(uint8_t id, int x, int y, uint8_t tile)
+
+Show sprite `id` as `tile` with its top left corner at `x`, `y` within the area. Use `LCD_TILE_NONE` to hide the sprite.
+Sprites with a higher `id` are drawn over those with a lower `id`.
+--- */
+void lcdTilesSprite(uint8_t id, int x, int y, uint8_t tile) {
+	if (id >= LCD_TILES_SPRITES)
+		return;
+	_lcd_tiles_sprites[id].x = x;
+	_lcd_tiles_sprites[id].y = y;
+	_lcd_tiles_sprites[id].tile = tile;
+}
+
+/* ---
+#### void lcdTilesSpriteKey(uint8_t color)
+
+Make the pixels of the sprites which are `color` transparent. Use `LCD_TILE_OPAQUE` _(the default)_ to draw every pixel.
+--- */
+void lcdTilesSpriteKey(uint8_t color) {
+	if ((color != LCD_TILE_OPAQUE) && (color > LCD_BLACK))
+		color = LCD_BLACK;
+	_lcd_tiles_key = color;
+	for (uint8_t s = 0; s < LCD_TILES_SPRITES; s++)
+		_lcd_tiles_sprites[s].drawn_tile = _LCD_TILES_DIRTY;	// the visible sprites must be drawn again
+}
+
+/* ---
+#### void lcdTilesInvalidate()
+
+Send every cell on the next render _(eg: after drawing directly over the area)_.
+--- */
+void lcdTilesInvalidate() {
+	memset(_lcd_tiles_drawn, _LCD_TILES_DIRTY, sizeof(_lcd_tiles_drawn));
+}
+
+/* ---
+#### int lcdTilesRender()
+
+Send the cells whose tile has changed and the cells under the sprites which have changed.
+Empty cells use the current background color.
+
+Returns the number of cells sent.
+--- */
+int lcdTilesRender() {
+	if (!_lcd_init) return 0;
+	if (!_lcd_tiles_cols) return 0;
+
+	_lcd_tiles_bg = lcdColorTripletGetB();
+
+	// the cells under the old and new position of each changed sprite
+	for (uint8_t s = 0; s < LCD_TILES_SPRITES; s++) {
+		_LCD_TILES_SPRITE *sprite = &_lcd_tiles_sprites[s];
+		if ((sprite->tile == sprite->drawn_tile) && (sprite->x == sprite->drawn_x) && (sprite->y == sprite->drawn_y))
+			continue;
+		if (sprite->drawn_tile != LCD_TILE_NONE)
+			_lcd_tiles_mark(sprite->drawn_x, sprite->drawn_y);
+		if (sprite->tile != LCD_TILE_NONE)
+			_lcd_tiles_mark(sprite->x, sprite->y);
+		sprite->drawn_x = sprite->x;
+		sprite->drawn_y = sprite->y;
+		sprite->drawn_tile = sprite->tile;
+	}
+
+	int cells = 0;
+	for (uint8_t row = 0; row < _lcd_tiles_rows; row++) {
+		uint8_t *drawn = &_lcd_tiles_drawn[row * _lcd_tiles_cols];
+		uint8_t c = 0;
+		while (c < _lcd_tiles_cols) {
+			uint8_t tile = _lcd_tiles_cell(c, row);
+			if (drawn[c] == tile) {
+				c++;
+				continue;
+			}
+			// a run of changed cells
+			uint8_t c0 = c;
+			do {
+				drawn[c++] = tile;
+				if (c < _lcd_tiles_cols)
+					tile = _lcd_tiles_cell(c, row);
+			} while ((c < _lcd_tiles_cols) && (drawn[c] != tile));
+
+			_lcd_tiles_run(row, c0, c - 1);
+			cells += c - c0;
+		}
+	}
+	return cells;
+}
+
+#endif // LCD_TILES
+#endif // __SRXE_LCDTILES_
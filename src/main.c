@@ -80,6 +80,47 @@ const char *_softkey_menu_names[] = {"<--", NULL, NULL, NULL, NULL, "-->", NULL,
 
 long debug_call_count = 0;
 
+// the last event is shown on the screen; only its line is repainted when it changes
+static KMSG _debug_last_event;
+static uint8_t _debug_menu_width = 0;	// 0 until the menu has been drawn
+
+// the area of the event line, using FONT3
+static KRECT _debug_event_rect(void)
+{
+	lcdFontSet(FONT3);
+	return (KRECT){30, lcdFontHeightGet() * 2, lcdTextWidthGet("00:0000"), lcdFontHeightGet()};
+}
+
+static void _debug_paint(void)
+{
+	lcdFontSet(FONT3);
+
+	char buff[10];
+
+	// Print the message
+	if (KernalPaintNeeded(30, lcdFontHeightGet(), lcdTextWidthGet("Update Flags:"), lcdFontHeightGet()))
+		lcdPutStringAt("Update Flags:", 30, lcdFontHeightGet());
+
+	KRECT r = _debug_event_rect();
+	if (KernalPaintNeeded(r.x, r.y, r.cx, r.cy))
+	{
+		// Print event flags
+		sprintf_(buff, "%02X", _debug_last_event.event_id);
+		lcdPutStringAt(buff, 30, lcdFontHeightGet() * 2);
+
+		lcdPutStringAt(":", 30 + lcdFontWidthGet() * 2, lcdFontHeightGet() * 2);
+
+		// Print event data
+		sprintf_(buff, "%04X", _debug_last_event.event_data);
+		lcdPutStringAt(buff, 30 + lcdFontWidthGet() * 3, lcdFontHeightGet() * 2);
+	}
+
+	if (!_debug_menu_width ||
+		KernalPaintNeeded(0, 0, _debug_menu_width, LCD_HEIGHT) ||
+		KernalPaintNeeded(LCD_WIDTH - _debug_menu_width, 0, _debug_menu_width, LCD_HEIGHT))
+		_debug_menu_width = uiMenu(_softkey_menu_names, NULL, UI_MENU_ROUND_END, false);
+}
+
 KERNAL_EVENT_HANDLER_RETURN debug_event_handler(KMSG *event)
 {
 	KERNAL_EVENT_HANDLER_RETURN ret = {.error = 0, .error_message = NULL};
@@ -96,29 +137,21 @@ KERNAL_EVENT_HANDLER_RETURN debug_event_handler(KMSG *event)
 		break;
 	case KERNAL_EVENT_WAKEUP:
 		break;
+	case KERNAL_EVENT_PAINT:
+		_debug_paint();
+		return ret;
 	default:
 		ret = (KERNAL_EVENT_HANDLER_RETURN){.error = 1, .error_message = "event handler Unknown event"};
 		break;
 	}
 
-	lcdFontSet(FONT3);
-
-	char buff[10];
-
-	// Print the message
-	lcdPutStringAt("Update Flags:", 30, lcdFontHeightGet());
-
-	// Print event flags
-	sprintf_(buff, "%02X", event->event_id);
-	lcdPutStringAt(buff, 30, lcdFontHeightGet() * 2);
-
-	lcdPutStringAt(":", 30 + lcdFontWidthGet() * 2, lcdFontHeightGet() * 2);
-
-	// Print event data
-	sprintf_(buff, "%04X", event->event_data);
-	lcdPutStringAt(buff, 30 + lcdFontWidthGet() * 3, lcdFontHeightGet() * 2);
-
-	uiMenu(_softkey_menu_names, NULL, UI_MENU_ROUND_END, false);
+	// nothing is drawn here; the event line is repainted once the kernal has no other events waiting
+	if ((event->event_id != _debug_last_event.event_id) || (event->event_data != _debug_last_event.event_data))
+	{
+		_debug_last_event = *event;
+		KRECT r = _debug_event_rect();
+		InvalidateRect(&r);
+	}
 
 	return ret;
 }
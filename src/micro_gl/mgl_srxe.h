@@ -0,0 +1,294 @@
+/* MicroGL - SRXE backend
+ *
+ * Implements the micro_gl user functions with the SRXEcore LCD functions.
+ *
+ * The coordinates are the same as the LCD functions:
+ * horizontal dimensions are in display triplets (3 pixels) and vertical dimensions are in pixels.
+ * The exception is _MGL_draw_pixel() which uses real pixels in both directions.
+ * The colors are LCD_WHITE, LCD_LIGHT, LCD_DARK, and LCD_BLACK.
+ *
+ * The LCD can not read back its memory and can only write whole triplets so single pixels and small
+ * rectangles are collected in a cache of row spans. A pixel changes its part of a cached triplet; the
+ * other pixels of a new triplet are the background color of the call which added it.
+ * When the cache is full the changed spans are sent and kept; a sent span is only dropped, the least
+ * recently used first, to make room. A later pixel in a triplet which is still cached keeps the pixels
+ * drawn before it, so a line or circle is not cut by the cache filling part way through.
+ * _MGL_flush() sends the changed spans and empties the cache; spans with the same columns on consecutive
+ * rows share one window. Strings, frames, and large rectangles flush the cache and are then drawn directly.
+ */
+
+#ifndef MGL_SRXE_H
+#define MGL_SRXE_H
+
+#include "../lcdbase.h"
+#include "../lcddraw.h"
+#include "../lcdtext.h"
+
+#ifndef MGL_SPAN_COUNT
+#define MGL_SPAN_COUNT 16	// spans in the cache
+#endif
+
+#ifndef MGL_SPAN_MAX
+#define MGL_SPAN_MAX 16		// triplets in one span
+#endif
+
+typedef struct
+{
+	uint8_t y, x, cx;				// the row and the triplets of the span
+	bool dirty;						// changed since it was last sent
+	uint8_t used;					// the tick of its last use
+	uint8_t data[MGL_SPAN_MAX];
+} _MGL_SRXE_SPAN;
+
+static _MGL_SRXE_SPAN _mgl_srxe_spans[MGL_SPAN_COUNT];
+static uint8_t _mgl_srxe_span_count;
+static uint8_t _mgl_srxe_tick;
+
+static int _mgl_srxe_fg = LCD_BLACK;
+static int _mgl_srxe_bg = LCD_WHITE;
+
+// send the changed spans and keep them as clean; they are grouped by their columns so consecutive rows with the same columns use one window
+static void _mgl_srxe_send()
+{
+	uint8_t order[MGL_SPAN_COUNT];
+	uint8_t count = 0;
+
+	for (uint8_t i = 0; i < _mgl_srxe_span_count; i++)
+	{
+		_MGL_SRXE_SPAN *s = &_mgl_srxe_spans[i];
+		if (!s->dirty)
+			continue;
+		s->dirty = false;
+		uint8_t j = count++;
+		for (; j > 0; j--)
+		{
+			_MGL_SRXE_SPAN *o = &_mgl_srxe_spans[order[j - 1]];
+			if ((o->x < s->x) || ((o->x == s->x) && ((o->cx < s->cx) || ((o->cx == s->cx) && (o->y < s->y)))))
+				break;
+			order[j] = order[j - 1];
+		}
+		order[j] = i;
+	}
+
+	for (uint8_t i = 0; i < count;)
+	{
+		_MGL_SRXE_SPAN *first = &_mgl_srxe_spans[order[i]];
+		uint8_t rows = 1;
+		while ((i + rows) < count)
+		{
+			_MGL_SRXE_SPAN *s = &_mgl_srxe_spans[order[i + rows]];
+			if ((s->x != first->x) || (s->cx != first->cx) || (s->y != (first->y + rows)))
+				break;
+			rows++;
+		}
+
+		_lcd_set_active_area(first->x, first->y, first->cx, rows);
+		for (uint8_t r = 0; r < rows; r++)
+			_lcd_write_data_block(_mgl_srxe_spans[order[i + r]].data, first->cx);
+		_lcd_end_active_area();
+		i += rows;
+	}
+}
+
+// send the cache and empty it; the screen may be drawn directly after this
+void _MGL_flush()
+{
+	_mgl_srxe_send();
+	_mgl_srxe_span_count = 0;
+}
+
+static void _mgl_srxe_remove(uint8_t i)
+{
+	_mgl_srxe_spans[i] = _mgl_srxe_spans[--_mgl_srxe_span_count];
+}
+
+// make room for a span: drop the least recently used clean span, sending the changed spans first if there is none
+static void _mgl_srxe_evict()
+{
+	uint8_t oldest = MGL_SPAN_COUNT;
+	uint8_t age = 0;
+
+	for (uint8_t pass = 0; pass < 2; pass++)
+	{
+		for (uint8_t i = 0; i < _mgl_srxe_span_count; i++)
+		{
+			_MGL_SRXE_SPAN *s = &_mgl_srxe_spans[i];
+			if (!s->dirty && ((oldest == MGL_SPAN_COUNT) || ((uint8_t)(_mgl_srxe_tick - s->used) > age)))
+			{
+				oldest = i;
+				age = _mgl_srxe_tick - s->used;
+			}
+		}
+		if (oldest < MGL_SPAN_COUNT)
+			break;
+		_mgl_srxe_send();
+	}
+	_mgl_srxe_remove(oldest);
+}
+
+// the span which holds the triplets x to x + cx - 1 of a row; it is marked as changed
+// triplets new to the cache are set to the background byte
+static _MGL_SRXE_SPAN *_mgl_srxe_span(uint8_t y, uint8_t x, uint8_t cx, uint8_t bg)
+{
+	_MGL_SRXE_SPAN *span = NULL;
+	uint8_t touching = 0;
+
+	_mgl_srxe_tick++;
+	for (uint8_t i = 0; i < _mgl_srxe_span_count; i++)
+	{
+		_MGL_SRXE_SPAN *s = &_mgl_srxe_spans[i];
+		if ((s->y == y) && (x <= (s->x + s->cx)) && ((x + cx) >= s->x))
+		{
+			span = s;
+			touching++;
+			if ((s->x <= x) && ((x + cx) <= (s->x + s->cx)))
+			{
+				touching = 1;	// a span which holds all of them is used as it is
+				break;
+			}
+		}
+	}
+
+	if (touching == 1)
+	{
+		uint8_t x0 = (x < span->x) ? x : span->x;
+		uint8_t x1 = ((x + cx) > (span->x + span->cx)) ? (x + cx) : (span->x + span->cx);
+		if ((x1 - x0) <= MGL_SPAN_MAX)
+		{
+			uint8_t shift = span->x - x0;
+			if (shift)
+			{
+				memmove(&span->data[shift], span->data, span->cx);
+				memset(span->data, bg, shift);
+				span->x = x0;
+				span->cx += shift;
+			}
+			if (x1 > (span->x + span->cx))
+			{
+				memset(&span->data[span->cx], bg, x1 - (span->x + span->cx));
+				span->cx = x1 - span->x;
+			}
+			span->dirty = true;
+			span->used = _mgl_srxe_tick;
+			return span;
+		}
+	}
+
+	// a span can not grow past MGL_SPAN_MAX or into another span so a new span is started
+	// a pixel is in no cached triplet here; a rectangle replaces whole triplets so the spans it overlaps are trimmed
+	for (uint8_t i = _mgl_srxe_span_count; i-- > 0;)
+	{
+		_MGL_SRXE_SPAN *s = &_mgl_srxe_spans[i];
+		if ((s->y != y) || (x >= (s->x + s->cx)) || ((x + cx) <= s->x))
+			continue;
+		if (s->x < x)
+		{
+			s->cx = x - s->x;
+		}
+		else if ((s->x + s->cx) > (x + cx))
+		{
+			uint8_t cut = (x + cx) - s->x;
+			memmove(s->data, &s->data[cut], s->cx - cut);
+			s->x += cut;
+			s->cx -= cut;
+		}
+		else
+		{
+			_mgl_srxe_remove(i);
+		}
+	}
+
+	if (_mgl_srxe_span_count >= MGL_SPAN_COUNT)
+		_mgl_srxe_evict();
+
+	span = &_mgl_srxe_spans[_mgl_srxe_span_count++];
+	span->y = y;
+	span->x = x;
+	span->cx = cx;
+	span->dirty = true;
+	span->used = _mgl_srxe_tick;
+	memset(span->data, bg, cx);
+	return span;
+}
+
+// x is in real pixels; the other pixels of the triplet keep their cached value or are the background color
+void _MGL_draw_pixel(int x, int y, int fg, int bg)
+{
+	static const uint8_t masks[3] = {0b11100000, 0b00011100, 0b00000011};
+
+	if ((x < 0) || (y < 0) || (x >= (LCD_WIDTH * 3)) || (y >= LCD_HEIGHT))
+		return;
+
+	uint8_t t = x / 3;
+	uint8_t m = masks[x % 3];
+	_MGL_SRXE_SPAN *s = _mgl_srxe_span(y, t, 1, _lcd_color_to_byte[bg & 3]);
+	uint8_t *p = &s->data[t - s->x];
+	*p = (*p & ~m) | (_lcd_color_to_byte[fg & 3] & m);
+}
+
+void _MGL_fill_rect(int x, int y, int w, int h, int color)
+{
+	if (x < 0)	{ w += x; x = 0; }
+	if (y < 0)	{ h += y; y = 0; }
+	if ((x + w) > LCD_WIDTH)	w = LCD_WIDTH - x;
+	if ((y + h) > LCD_HEIGHT)	h = LCD_HEIGHT - y;
+	if ((w < 1) || (h < 1))
+		return;
+
+	// a small rectangle joins the cache; each of its rows is a span
+	if ((w <= MGL_SPAN_MAX) && (h <= MGL_SPAN_COUNT))
+	{
+		uint8_t b = _lcd_color_to_byte[color & 3];
+		for (int r = 0; r < h; r++)
+		{
+			_MGL_SRXE_SPAN *s = _mgl_srxe_span(y + r, x, w, b);
+			memset(&s->data[x - s->x], b, w);
+		}
+		return;
+	}
+
+	// an erased rectangle is a single window of the background color
+	_MGL_flush();
+	lcdColorSet(color, color);
+	lcdRectangle(x, y, w, h, LCD_ERASE);
+	lcdColorSet(_mgl_srxe_fg, _mgl_srxe_bg);
+}
+
+// the outer pixels of the edge triplets are the color; the others are the current background color
+void _MGL_frame_rect(int x, int y, int w, int h, int color)
+{
+	if ((w < 1) || (h < 1))
+		return;
+	_MGL_flush();
+	lcdColorSet(color, _mgl_srxe_bg);
+	lcdRectangle(x, y, w, h, LCD_HOLLOW);
+	lcdColorSet(_mgl_srxe_fg, _mgl_srxe_bg);
+}
+
+// the text cells are drawn in the color on the current background color
+void _MGL_put_string(int x, int y, const char *str, int color)
+{
+	_MGL_flush();
+	lcdColorSet(color, _mgl_srxe_bg);
+	lcdPutStringAt(str, x, y);
+	lcdColorSet(_mgl_srxe_fg, _mgl_srxe_bg);
+}
+
+void _MGL_set_color(int fg, int bg)
+{
+	_mgl_srxe_fg = fg;
+	_mgl_srxe_bg = bg;
+	lcdColorSet(fg, bg);
+}
+
+int _MGL_get_active_font_height()
+{
+	return lcdFontHeightGet();
+}
+
+int _MGL_get_active_font_width()
+{
+	return lcdFontWidthGet();
+}
+
+#endif
@@ -2,26 +2,616 @@
  * Auther: Hailey Gruszynski
  * Date: 2023-JAN-02
  *
- * Version: 0.0.0 -- Gray scale only
+ * Version: 0.1.0 -- Gray scale only
+ *
+ * A retained mode widget tree: labels, buttons, lists, progress bars, and panels.
+ *
+ * The widgets come from a fixed pool of MGL_POOL_SIZE nodes; nothing is allocated.
+ * Changing a property only records the change. mglRender() compares each widget with the state it last
+ * drew and sends only the fills and strings needed to bring the screen up to date
+ * (eg: a progress bar only fills the part of the bar between the old and new value).
+ *
+ * Positions are relative to the parent widget. The units are those of the user functions
+ * (for the SRXE: horizontal in triplets, vertical in pixels). The widgets use the active font.
+ *
+ * mglPixel(), mglLine(), and mglCircle() draw directly and are not part of the widget tree.
+ * Their units are those of _MGL_draw_pixel() (for the SRXE: real pixels in both directions).
+ * A backend may hold the pixels until mglFlush() or mglRender().
  */
 
 #ifndef MICRO_GL_H
 #define MICRO_GL_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
 //----------------FUNCTIONS THE USER MUST IMPLEMENT----------------//
 
 // -- USER INCLUDES -- //
-#include "../lcdbase.h"
+#include "mgl_srxe.h"
 
 void _MGL_draw_pixel(int x, int y, int fg, int bg);
 void _MGL_fill_rect(int x, int y, int w, int h, int color);
-void _MGL_put_string(int x, int y, char *str, int color);
+void _MGL_frame_rect(int x, int y, int w, int h, int color);
+void _MGL_put_string(int x, int y, const char *str, int color);
 void _MGL_set_color(int fg, int bg);
+void _MGL_flush();
 int _MGL_get_active_font_height();
 int _MGL_get_active_font_width();
 //-----------------------------------------------------------------//
 
+#ifndef MGL_POOL_SIZE
+#define MGL_POOL_SIZE 16
+#endif
+
+#ifndef MGL_TEXT_MAX
+#define MGL_TEXT_MAX 20		// longest label or button text; longer text is truncated
+#endif
+
+typedef uint8_t MGL_ID;
+#define MGL_NONE 0xFF
+
+// widget types
+#define _MGL_FREE		0
+#define MGL_PANEL		1
+#define MGL_LABEL		2
+#define MGL_BUTTON		3
+#define MGL_LIST		4
+#define MGL_PROGRESS	5
+
+// widget flags
+#define MGL_VISIBLE		0x01
+#define MGL_FOCUSED		0x02
+#define MGL_PRESSED		0x04
+#define MGL_BORDER		0x08	// panels only
+
+// changes which can not be found by comparing with the drawn state
+#define _MGL_DIRTY_ALL	0x01	// the whole widget, including its background
+#define _MGL_DIRTY_TEXT	0x02
+
+typedef struct
+{
+	uint8_t type;
+	uint8_t flags;
+	MGL_ID parent, child, next;		// the tree; children are drawn over their parent in order
+	int x, y, w, h;					// relative to the parent
+	uint8_t fg, bg;
+	char text[MGL_TEXT_MAX + 1];	// label and button
+	const char **items;				// list
+	uint16_t value, max;			// progress value and maximum; list selection and item count
+	uint16_t first;					// list: the first visible item
+
+	// the state at the last render
+	uint8_t dirty;
+	uint8_t drawn_flags;
+	int drawn_width;				// label: the width of the text; progress: the width of the bar
+	uint8_t drawn_same;				// label: the characters at the start of the text which have not changed
+	uint16_t drawn_value, drawn_first;
+} MGL_WIDGET;
+
+static MGL_WIDGET _mgl_pool[MGL_POOL_SIZE];
+static MGL_ID _mgl_root = MGL_NONE;
+
+//-------------------------INTERNAL -------------------------------//
+
+static MGL_WIDGET *_mgl_get(MGL_ID id)
+{
+	if ((id >= MGL_POOL_SIZE) || (_mgl_pool[id].type == _MGL_FREE))
+		return NULL;
+	return &_mgl_pool[id];
+}
+
+// mark a widget and everything on it to be drawn completely
+static void _mgl_dirty_tree(MGL_ID id)
+{
+	MGL_WIDGET *w = &_mgl_pool[id];
+	w->dirty |= _MGL_DIRTY_ALL;
+	for (MGL_ID c = w->child; c != MGL_NONE; c = _mgl_pool[c].next)
+		_mgl_dirty_tree(c);
+}
+
+static MGL_ID _mgl_new(uint8_t type, MGL_ID parent, int x, int y, int w, int h)
+{
+	if ((parent != MGL_NONE) && !_mgl_get(parent))
+		return MGL_NONE;
+
+	for (MGL_ID id = 0; id < MGL_POOL_SIZE; id++)
+	{
+		MGL_WIDGET *n = &_mgl_pool[id];
+		if (n->type != _MGL_FREE)
+			continue;
+
+		memset(n, 0, sizeof(MGL_WIDGET));
+		n->type = type;
+		n->flags = MGL_VISIBLE;
+		n->parent = parent;
+		n->child = MGL_NONE;
+		n->next = MGL_NONE;
+		n->x = x;
+		n->y = y;
+		n->w = w;
+		n->h = h;
+		n->fg = LCD_BLACK;
+		n->bg = (parent == MGL_NONE) ? LCD_WHITE : _mgl_pool[parent].bg;
+		n->dirty = _MGL_DIRTY_ALL;
+
+		// add at the end of the siblings so it is drawn last
+		MGL_ID *link = (parent == MGL_NONE) ? &_mgl_root : &_mgl_pool[parent].child;
+		while (*link != MGL_NONE)
+			link = &_mgl_pool[*link].next;
+		*link = id;
+		return id;
+	}
+	return MGL_NONE;
+}
+
+static void _mgl_copy(char *out, const char *text)
+{
+	strncpy(out, text, MGL_TEXT_MAX);
+	out[MGL_TEXT_MAX] = 0;
+}
+
+// the text which fits in a width
+static void _mgl_fit(char *out, const char *text, int width)
+{
+	int fw = _MGL_get_active_font_width();
+	int count = ((fw > 0) && (width > 0)) ? (width / fw) : 0;
+	int len = strlen(text);
+	if (count > len)
+		count = len;
+	if (count > MGL_TEXT_MAX)
+		count = MGL_TEXT_MAX;
+	memcpy(out, text, count);
+	out[count] = 0;
+}
+
+static void _mgl_draw_label(MGL_WIDGET *w, int ax, int ay)
+{
+	char text[MGL_TEXT_MAX + 1];
+	_mgl_fit(text, w->text, w->w);
+	int width = strlen(text) * _MGL_get_active_font_width();
+
+	int same = 0;
+	_MGL_set_color(w->fg, w->bg);
+	if (w->dirty & _MGL_DIRTY_ALL)
+		_MGL_fill_rect(ax, ay, w->w, w->h, w->bg);
+	else
+	{
+		same = w->drawn_same;
+		if (width < w->drawn_width)
+			_MGL_fill_rect(ax + width, ay, w->drawn_width - width, w->h, w->bg);	// only the end of the old text
+	}
+	// only the text after the characters which have not changed is sent
+	if (same < (int)strlen(text))
+		_MGL_put_string(ax + (same * _MGL_get_active_font_width()), ay, text + same, w->fg);
+	w->drawn_width = width;
+}
+
+static void _mgl_draw_button(MGL_WIDGET *w, int ax, int ay)
+{
+	bool pressed = (w->flags & MGL_PRESSED);
+	uint8_t face = pressed ? w->fg : w->bg;
+	uint8_t ink = pressed ? w->bg : w->fg;
+
+	if ((w->dirty & (_MGL_DIRTY_ALL | _MGL_DIRTY_TEXT)) || ((w->flags ^ w->drawn_flags) & MGL_PRESSED))
+	{
+		char text[MGL_TEXT_MAX + 1];
+		_mgl_fit(text, w->text, w->w - 4);	// clear of the border and the focus frame
+		int tw = strlen(text) * _MGL_get_active_font_width();
+		int th = _MGL_get_active_font_height();
+
+		_MGL_set_color(ink, face);
+		_MGL_fill_rect(ax, ay, w->w, w->h, face);
+		_MGL_put_string(ax + ((w->w - tw) / 2), ay + ((w->h - th) / 2), text, ink);
+		_MGL_set_color(w->fg, face);
+		_MGL_frame_rect(ax, ay, w->w, w->h, w->fg);
+		w->drawn_flags &= ~MGL_FOCUSED;	// the face covered the focus frame
+	}
+
+	// the focus is a second frame just inside the border
+	if ((w->flags ^ w->drawn_flags) & MGL_FOCUSED)
+	{
+		_MGL_set_color(w->fg, face);
+		_MGL_frame_rect(ax + 1, ay + 1, w->w - 2, w->h - 2, (w->flags & MGL_FOCUSED) ? ink : face);
+	}
+}
+
+static void _mgl_draw_progress(MGL_WIDGET *w, int ax, int ay)
+{
+	int inside = w->w - 2;
+	int bar = w->max ? (int)(((long)inside * ((w->value > w->max) ? w->max : w->value)) / w->max) : 0;
+
+	_MGL_set_color(w->fg, w->bg);
+	if (w->dirty & _MGL_DIRTY_ALL)
+	{
+		_MGL_fill_rect(ax, ay, w->w, w->h, w->bg);
+		_MGL_frame_rect(ax, ay, w->w, w->h, w->fg);
+		w->drawn_width = 0;
+	}
+	// only the part between the old and new end of the bar
+	if (bar > w->drawn_width)
+		_MGL_fill_rect(ax + 1 + w->drawn_width, ay + 2, bar - w->drawn_width, w->h - 4, w->fg);
+	else if (bar < w->drawn_width)
+		_MGL_fill_rect(ax + 1 + bar, ay + 2, w->drawn_width - bar, w->h - 4, w->bg);
+	w->drawn_width = bar;
+}
+
+static void _mgl_draw_list_row(MGL_WIDGET *w, int ax, int ay, uint16_t item)
+{
+	int fh = _MGL_get_active_font_height();
+	int y = ay + ((item - w->first) * fh);
+	bool selected = (item == w->value);
+	uint8_t face = selected ? w->fg : w->bg;
+	uint8_t ink = selected ? w->bg : w->fg;
+
+	char text[MGL_TEXT_MAX + 1];
+	_mgl_fit(text, (item < w->max) ? w->items[item] : "", w->w);
+	int tw = strlen(text) * _MGL_get_active_font_width();
+
+	_MGL_set_color(ink, face);
+	if (tw)
+		_MGL_put_string(ax, y, text, ink);
+	_MGL_fill_rect(ax + tw, y, w->w - tw, fh, face);
+}
+
+static void _mgl_draw_list(MGL_WIDGET *w, int ax, int ay)
+{
+	int fh = _MGL_get_active_font_height();
+	uint16_t rows = (fh > 0) ? (w->h / fh) : 0;
+
+	if ((w->dirty & _MGL_DIRTY_ALL) || (w->first != w->drawn_first))
+	{
+		_MGL_set_color(w->fg, w->bg);
+		if (w->h > (int)(rows * fh))
+			_MGL_fill_rect(ax, ay + (rows * fh), w->w, w->h - (rows * fh), w->bg);
+		for (uint16_t r = 0; r < rows; r++)
+			_mgl_draw_list_row(w, ax, ay, w->first + r);
+	}
+	else if (w->value != w->drawn_value)
+	{
+		// only the rows of the old and the new selection
+		if ((w->drawn_value >= w->first) && (w->drawn_value < (w->first + rows)))
+			_mgl_draw_list_row(w, ax, ay, w->drawn_value);
+		if ((w->value >= w->first) && (w->value < (w->first + rows)))
+			_mgl_draw_list_row(w, ax, ay, w->value);
+	}
+	w->drawn_value = w->value;
+	w->drawn_first = w->first;
+}
+
+static void _mgl_draw_panel(MGL_WIDGET *w, int ax, int ay)
+{
+	if (!(w->dirty & _MGL_DIRTY_ALL))
+		return;
+	_MGL_set_color(w->fg, w->bg);
+	_MGL_fill_rect(ax, ay, w->w, w->h, w->bg);
+	if (w->flags & MGL_BORDER)
+		_MGL_frame_rect(ax, ay, w->w, w->h, w->fg);
+}
+
+// the background behind a widget; a hidden widget is covered with it
+static uint8_t _mgl_behind(MGL_WIDGET *w)
+{
+	return (w->parent == MGL_NONE) ? LCD_WHITE : _mgl_pool[w->parent].bg;
+}
+
+static void _mgl_render(MGL_ID id, int px, int py)
+{
+	MGL_WIDGET *w = &_mgl_pool[id];
+	int ax = px + w->x;
+	int ay = py + w->y;
+
+	if (!(w->flags & MGL_VISIBLE))
+	{
+		if (w->drawn_flags & MGL_VISIBLE)
+		{
+			_MGL_set_color(w->fg, _mgl_behind(w));
+			_MGL_fill_rect(ax, ay, w->w, w->h, _mgl_behind(w));
+			w->drawn_flags = 0;
+		}
+		return;
+	}
+
+	if (!(w->drawn_flags & MGL_VISIBLE))
+		_mgl_dirty_tree(id);	// shown again
+
+	// everything on a widget which is drawn completely must also be drawn
+	if ((w->dirty & _MGL_DIRTY_ALL) && (w->type == MGL_PANEL))
+		_mgl_dirty_tree(id);
+
+	switch (w->type)
+	{
+	case MGL_PANEL:
+		_mgl_draw_panel(w, ax, ay);
+		break;
+	case MGL_LABEL:
+		if (w->dirty)
+			_mgl_draw_label(w, ax, ay);
+		break;
+	case MGL_BUTTON:
+		_mgl_draw_button(w, ax, ay);
+		break;
+	case MGL_LIST:
+		_mgl_draw_list(w, ax, ay);
+		break;
+	case MGL_PROGRESS:
+		_mgl_draw_progress(w, ax, ay);
+		break;
+	}
+	w->dirty = 0;
+	w->drawn_flags = w->flags;
+
+	for (MGL_ID c = w->child; c != MGL_NONE; c = _mgl_pool[c].next)
+		_mgl_render(c, ax, ay);
+}
+
 //-------------------------EXPOSED API ----------------------------//
+
+// Remove all widgets
+void mglReset()
+{
+	memset(_mgl_pool, 0, sizeof(_mgl_pool));
+	_mgl_root = MGL_NONE;
+}
+
+// Create a panel; other widgets may be placed on it. Use MGL_NONE as the parent for a top level widget.
+MGL_ID mglPanel(MGL_ID parent, int x, int y, int w, int h, bool border)
+{
+	MGL_ID id = _mgl_new(MGL_PANEL, parent, x, y, w, h);
+	if (border && (id != MGL_NONE))
+		_mgl_pool[id].flags |= MGL_BORDER;
+	return id;
+}
+
+// Create a label one line of the active font high
+MGL_ID mglLabel(MGL_ID parent, int x, int y, int w, const char *text)
+{
+	MGL_ID id = _mgl_new(MGL_LABEL, parent, x, y, w, _MGL_get_active_font_height());
+	if (id != MGL_NONE)
+		_mgl_copy(_mgl_pool[id].text, text);
+	return id;
+}
+
+// Create a button with centered text
+MGL_ID mglButton(MGL_ID parent, int x, int y, int w, int h, const char *text)
+{
+	MGL_ID id = _mgl_new(MGL_BUTTON, parent, x, y, w, h);
+	if (id != MGL_NONE)
+		_mgl_copy(_mgl_pool[id].text, text);
+	return id;
+}
+
+// Create a list of items; the items are not copied and must remain valid
+MGL_ID mglList(MGL_ID parent, int x, int y, int w, int h, const char **items, uint16_t count)
+{
+	MGL_ID id = _mgl_new(MGL_LIST, parent, x, y, w, h);
+	if (id != MGL_NONE)
+	{
+		_mgl_pool[id].items = items;
+		_mgl_pool[id].max = count;
+	}
+	return id;
+}
+
+// Create a progress bar from 0 to max
+MGL_ID mglProgress(MGL_ID parent, int x, int y, int w, int h, uint16_t max)
+{
+	MGL_ID id = _mgl_new(MGL_PROGRESS, parent, x, y, w, h);
+	if (id != MGL_NONE)
+		_mgl_pool[id].max = max;
+	return id;
+}
+
+// return a widget and everything on it to the pool
+static void _mgl_free(MGL_ID id)
+{
+	MGL_WIDGET *w = &_mgl_pool[id];
+
+	while (w->child != MGL_NONE)
+		_mgl_free(w->child);
+
+	MGL_ID *link = (w->parent == MGL_NONE) ? &_mgl_root : &_mgl_pool[w->parent].child;
+	while (*link != id)
+		link = &_mgl_pool[*link].next;
+	*link = w->next;
+	w->type = _MGL_FREE;
+}
+
+// Remove a widget and everything on it; if it is on the screen it is covered with the background behind it
+void mglDelete(MGL_ID id)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	if (!w)
+		return;
+
+	// it is on the screen only if it and every widget under it were visible at the last render
+	bool shown = true;
+	int ax = 0, ay = 0;
+	for (MGL_WIDGET *p = w; p; p = (p->parent == MGL_NONE) ? NULL : &_mgl_pool[p->parent])
+	{
+		shown &= (p->drawn_flags & MGL_VISIBLE) != 0;
+		ax += p->x;
+		ay += p->y;
+	}
+	if (shown)
+	{
+		_MGL_set_color(w->fg, _mgl_behind(w));
+		_MGL_fill_rect(ax, ay, w->w, w->h, _mgl_behind(w));
+	}
+
+	_mgl_free(id);
+}
+
+// Change the text of a label or a button; only a change is drawn
+void mglSetText(MGL_ID id, const char *text)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	if (!w)
+		return;
+	if (strncmp(w->text, text, MGL_TEXT_MAX) == 0)
+		return;
+
+	// the start which is the same as the drawn text; after several changes the shortest one
+	uint8_t same = 0;
+	while ((same < MGL_TEXT_MAX) && w->text[same] && (w->text[same] == text[same]))
+		same++;
+	if (!(w->dirty & _MGL_DIRTY_TEXT) || (same < w->drawn_same))
+		w->drawn_same = same;
+
+	_mgl_copy(w->text, text);
+	w->dirty |= _MGL_DIRTY_TEXT;
+}
+
+// Change the value of a progress bar or the selected item of a list; a list scrolls to show the selection
+void mglSetValue(MGL_ID id, uint16_t value)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	if (!w)
+		return;
+	w->value = value;
+
+	if (w->type == MGL_LIST)
+	{
+		int fh = _MGL_get_active_font_height();
+		uint16_t rows = (fh > 0) ? (w->h / fh) : 0;
+		if (w->value >= w->max)
+			w->value = w->max ? (w->max - 1) : 0;
+		if (w->value < w->first)
+			w->first = w->value;
+		else if (rows && (w->value >= (w->first + rows)))
+			w->first = w->value - rows + 1;
+	}
+}
+
+uint16_t mglGetValue(MGL_ID id)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	return w ? w->value : 0;
+}
+
+// Change the items of a list; the selection moves to the first item
+void mglSetItems(MGL_ID id, const char **items, uint16_t count)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	if (!w)
+		return;
+	w->items = items;
+	w->max = count;
+	w->value = 0;
+	w->first = 0;
+	w->dirty |= _MGL_DIRTY_ALL;
+}
+
+// Change the colors of a widget; the widgets on a panel keep their own colors
+void mglSetColors(MGL_ID id, uint8_t fg, uint8_t bg)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	if (!w)
+		return;
+	w->fg = fg;
+	w->bg = bg;
+	w->dirty |= _MGL_DIRTY_ALL;
+}
+
+// Set or clear MGL_VISIBLE, MGL_FOCUSED, or MGL_PRESSED
+void mglSetFlag(MGL_ID id, uint8_t flag, bool set)
+{
+	MGL_WIDGET *w = _mgl_get(id);
+	if (!w)
+		return;
+	if (set)
+		w->flags |= flag;
+	else
+		w->flags &= ~flag;
+}
+
+// Draw a widget and everything on it completely on the next render
+void mglInvalidate(MGL_ID id)
+{
+	if (_mgl_get(id))
+		_mgl_dirty_tree(id);
+}
+
+// Bring the screen up to date with the widgets
+void mglRender()
+{
+	for (MGL_ID id = _mgl_root; id != MGL_NONE; id = _mgl_pool[id].next)
+		_mgl_render(id, 0, 0);
+	_MGL_flush();
+}
+
+// Send anything the backend is still holding
+void mglFlush()
+{
+	_MGL_flush();
+}
+
+// Draw one pixel; bg is used by a backend which must also write the pixels next to it
+void mglPixel(int x, int y, uint8_t fg, uint8_t bg)
+{
+	_MGL_draw_pixel(x, y, fg, bg);
+}
+
+// Draw a line from (x0, y0) to (x1, y1) including both ends
+void mglLine(int x0, int y0, int x1, int y1, uint8_t fg, uint8_t bg)
+{
+	int dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+	int dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);
+	int sx = (x0 < x1) ? 1 : -1;
+	int sy = (y0 < y1) ? 1 : -1;
+	int err = dx + dy;
+
+	for (;;)
+	{
+		_MGL_draw_pixel(x0, y0, fg, bg);
+		if ((x0 == x1) && (y0 == y1))
+			break;
+		int e2 = 2 * err;
+		if (e2 >= dy)
+		{
+			err += dy;
+			x0 += sx;
+		}
+		if (e2 <= dx)
+		{
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+// Draw a circle of radius r around (cx, cy)
+void mglCircle(int cx, int cy, int r, uint8_t fg, uint8_t bg)
+{
+	int x = r;
+	int y = 0;
+	int err = 1 - r;
+
+	// the points of one octant are mirrored into the other seven
+	while (x >= y)
+	{
+		_MGL_draw_pixel(cx + x, cy + y, fg, bg);
+		_MGL_draw_pixel(cx + y, cy + x, fg, bg);
+		_MGL_draw_pixel(cx - y, cy + x, fg, bg);
+		_MGL_draw_pixel(cx - x, cy + y, fg, bg);
+		_MGL_draw_pixel(cx - x, cy - y, fg, bg);
+		_MGL_draw_pixel(cx - y, cy - x, fg, bg);
+		_MGL_draw_pixel(cx + y, cy - x, fg, bg);
+		_MGL_draw_pixel(cx + x, cy - y, fg, bg);
+		y++;
+		if (err < 0)
+		{
+			err += (2 * y) + 1;
+		}
+		else
+		{
+			x--;
+			err += 2 * (y - x) + 1;
+		}
+	}
+}
+
 //-----------------------------------------------------------------//
 
-#endif
\ No newline at end of file
+#endif
@@ -158,6 +158,8 @@ void my_sleep_function(uint8_t rf_state) {
 --- */
 void powerSleep(void) {
 
+	_srxe_spi_wait();	// let any queued LCD transfer finish before the ports are saved
+
 	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
 
 	cli();
@@ -90,6 +90,12 @@ void _putchar(char c) {
 	switch (_print_device) {
 #ifdef __SRXE_LCDTEXT_
 		case PRINT_LCD: {
+#ifdef __SRXE_LCDCONSOLE_
+			if (lcdConsoleActive()) {
+				lcdConsolePutChar(c);
+				break;
+			}
+#endif
 			if (c)
 				lcdPutChar(c);
 		} break;
@@ -1065,6 +1071,7 @@ void printDeviceSet(uint8_t device) {
 replacement for stdlib printf() function with the output going to the specified device.
 
 When used for output to LCD, this function will used the current LCD position, font, and colors. Do not use any newline or linefeed characters with the LCD.
+When the LCD console is active _(see `lcdConsoleBegin()`)_, the output goes to the console and newline characters start a new line.
 
 When used for output to the UART, linefeed and newline are not automatically added and must be part of the `fmt` string as appropriate.
 
@@ -1081,6 +1088,10 @@ int printDevicePrintf(uint8_t device, const char *format, ...) {
 	const int ret = _vsnprintf(_out_char, buffer, (size_t)-1, format, va);
 	va_end(va);
 
+	#ifdef __SRXE_LCDCONSOLE_
+	if (device == PRINT_LCD)
+		lcdConsoleFlush();	// the console collects the characters of a line; draw what is left
+	#endif
 	#ifdef __SRXE_RF_
 	if (device == PRINT_RF)
 		rfTransmitNow();
@@ -1105,4 +1116,44 @@ int printBufferPrintf(char* buffer, size_t size, const char *format, ...) {
 	return ret;
 }
 
+#ifdef SRXE_PROFILE
+/* ---
+#### void printProfile(uint8_t device, SRXEPROFILE* profile)
+
+Output the `SRXE_PROFILE` counters to the specified device, one counter per line.
+When `profile` is `NULL`, a snapshot of the current counters is used.
+
+When used for output to LCD, the lines start at the current LCD position and use the current font and colors.
+
+_(only available when `SRXE_PROFILE` is defined)_
+--- */
+void printProfile(uint8_t device, SRXEPROFILE *profile) {
+	SRXEPROFILE snapshot;
+	const char *names[] = {"spi bytes", "lcd commands", "lcd data", "lcd windows", "lcd us"};
+	char line[32];
+
+	if (!profile) {
+		srxeProfileSnapshot(&snapshot);
+		profile = &snapshot;
+	}
+	uint32_t values[] = {profile->spi_bytes, profile->lcd_commands, profile->lcd_data_bytes, profile->lcd_windows, profile->lcd_us};
+
+#ifdef __SRXE_LCDTEXT_
+	int x = lcdPositionGetX();
+	int y = lcdPositionGetY();
+#endif
+	for (uint8_t i = 0; i < (sizeof(values) / sizeof(values[0])); i++) {
+		printBufferPrintf(line, sizeof(line), "%-12s %lu", names[i], values[i]);
+#ifdef __SRXE_LCDTEXT_
+		if (device == PRINT_LCD) {
+			lcdPutStringAt(line, x, y);
+			y += lcdFontHeightGet();
+			continue;
+		}
+#endif
+		printDevicePrintf(device, "%s\n", line);
+	}
+}
+#endif
+
 #endif // _PRINTF_H_
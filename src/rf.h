@@ -21,6 +21,17 @@ of these functions.
 The RF transceiver has a hardware level 128 byte buffer.
 Data transmission functions are limited to this buffer size.
 
+Transmission is interrupt driven. Frames wait in a queue of `RF_TX_QUEUE_SIZE` _(default 4)_ frames;
+the end of each transmission loads the next frame so queued frames are sent back to back.
+The send functions only wait when the queue is full.
+A frame which has to wait for a reception to end is started by the RX_END interrupt. The transceiver drops a frame for
+another address without an interrupt; for that case a wait also starts a one-shot TIMER4 compare which tries again
+once the longest frame would have ended _(about 4.3ms)_.
+
+By default, frames are sent to every SRXE on the channel and there is no acknowledgement.
+After `rfAddressSet()`, the transceiver uses its extended operating mode: frames have an IEEE 802.15.4 MAC header,
+frames for other addresses are ignored, and a frame sent with `rfSendTo()` is acknowledged and retransmitted by the hardware.
+
 The RF transceiver uses approximately 12.5-14.5mA of power.
 
 --------------------------------------------------------------------------
@@ -152,12 +163,37 @@ They are:
 
 
 #define RF_TX_BUFFER_SIZE (HW_FRAME_TX_SIZE+1)				// could be larger but the current code does not need it
-#define RF_RX_BUFFER_SIZE (HW_FRAME_RX_SIZE * 2)			// it only needs to be larger than HW_FRAME_BUFFER_SIZE to allow for more than a single message to arrive before being read
 
-static uint8_t rfRxData[RF_RX_BUFFER_SIZE];
+#ifndef RF_RX_SLOTS
+#define RF_RX_SLOTS 4										// received frames which may wait to be read
+#endif
+
 static uint8_t rfTxData[RF_TX_BUFFER_SIZE];
 
 #include "cbuffer.h"
+#include "clock.h"
+
+/* ---
+#### RFFRAME
+
+A received frame from `rfRecvFrame()`.
+```C
+*/
+typedef struct {
+	uint8_t length;						// the number of bytes in data (the CRC is not included)
+	uint8_t rssi;						// the signal strength at the start of the frame (0 .. 28; 3dB steps from -90dBm)
+	uint8_t lqi;						// the link quality of the frame (0 .. 255)
+	uint16_t src;						// the short address of the sender after rfAddressSet(), otherwise RF_BROADCAST
+	uint32_t time;						// clockMicros() at the end of the frame
+	uint8_t data[HW_FRAME_RX_SIZE];
+} RFFRAME;
+/*
+```
+--- */
+
+static RFFRAME _rf_rx_slots[RF_RX_SLOTS];
+static volatile uint8_t _rf_rx_tail, _rf_rx_count;	// the slot at the tail is the oldest frame
+static uint8_t _rf_rx_offset;						// the next byte of the tail frame for the byte stream functions
 
 static cBufferObj _rf_obj;
 
@@ -170,53 +206,213 @@ static uint8_t _rf_signal; // reusable byte access from the INT vectors
 
 
 
-// RF TX is not handled by an interrupt. We process data synchronously to the frame buffer and then let it do it's thing.
-void RF_LOAD_FRAME() {
-	uint8_t length = 0;
-	int c;
-	uint8_t *bp = (uint8_t *)(&TRXFBST + 1);
+#ifndef RF_TX_QUEUE_SIZE
+#define RF_TX_QUEUE_SIZE 4
+#endif
 
-	while (length < (HW_FRAME_TX_SIZE - 1)) {
-		if ((c = bufferGet(&(_rf_obj.txBuffer))) < 0)
-			break;
-		bp[length++] = c;
-	}
-	bp[length++] = 0;
+#define RF_FRAME_MAX		(HW_FRAME_TX_SIZE - 2)		// the radio adds a 2 byte CRC to each frame
+#define RF_MAC_HEADER		9							// frame control, sequence number, PAN ID, destination, and source
+#define RF_BROADCAST		0xFFFF
+
+// the status of a frame from rfSendStatus()
+#define RF_TX_DONE			0							// sent; with rfSendTo() the frame was acknowledged
+#define RF_TX_PENDING		1
+#define RF_TX_NO_ACK		2							// rfSendTo() only: no acknowledgement after all of the retries
+#define RF_TX_BUSY			3							// rfSendTo() only: the channel was never clear
+
+typedef struct {
+	uint8_t length;
+	uint8_t data[RF_FRAME_MAX];
+} _RF_TX_FRAME;
+
+static _RF_TX_FRAME _rf_tx_queue[RF_TX_QUEUE_SIZE];
+static volatile uint8_t _rf_tx_head, _rf_tx_count;	// the frame at the head is being sent (or is next)
+static volatile uint8_t _rf_tx_seq;					// the sequence number of the next frame to be queued
+static volatile bool _rf_tx_busy;					// a frame is in the hardware frame buffer
+static uint8_t _rf_tx_results[64];					// 2 bits for each sequence number; the status once a frame is sent
+
+static bool _rf_ext;								// the extended operating mode is in use (RX_AACK_ON / TX_ARET_ON)
+static uint16_t _rf_pan_id, _rf_address;
+
+// change the transceiver state and wait for it; each of these transitions takes about 1us
+// the state values are the same as the commands
+static void _rf_state(uint8_t state) {
+	TRX_STATE = (TRX_STATE & 0xE0) | state;
+	while ((TRX_STATUS & 0x1F) != state)
+		;
+}
 
-	// length is the number of bytes we have loaded into the hardware frame buffer
+// return to receiving in the current mode
+static void _rf_rx_on() {
+	if (_rf_ext) {
+		_rf_state(CMD_PLL_ON);
+		_rf_state(CMD_RX_AACK_ON);
+	} else {
+		_rf_state(CMD_RX_ON);
+	}
+}
 
-	//_rf_tx_debug = 0 - length; // we do this to be able to track state while debugging
-	//The Transceiver State Control Register -- TRX_STATE controls the states of the radio.
-	// Setting the PLL state to PLL_ON begins the TX.
+#define _RF_TX_WAIT_US		4300						// the air time of the longest frame with its preamble and PHY header
+
+// try to start the queued frame again once a reception which may raise no interrupt has ended
+// TIMER4 runs once in CTC mode with a 64 prescaler; the compare interrupt stops it
+static void _rf_tx_wait() {
+	TCCR4B = 0;
+	TCCR4A = 0;
+	TCNT4 = 0;
+	OCR4A = (uint16_t)(((F_CPU / 64) * _RF_TX_WAIT_US) / 1000000UL) - 1;
+	TIFR4 = (1 << OCF4A);								// writing a one clears a compare which is still pending
+	TIMSK4 |= (1 << OCIE4A);
+	TCCR4B = (1 << WGM42) | (1 << CS41) | (1 << CS40);
+}
 
-	TRXFBST = 2 + length; // length (byte) +  n bytes of data
+static void _rf_tx_wait_stop() {
+	TCCR4B = 0;
+	TIMSK4 &= ~(1 << OCIE4A);
 }
 
-void RF_TX_FRAME() {
-	TRX_STATE = (TRX_STATE & 0xE0) | PLL_ON; // Set to TX start state
-	while (!(TRX_STATUS & PLL_ON))
-		; // Wait for PLL to lock
+// start sending the frame at the head of the queue; called with interrupts disabled
+// the radio moves RX_ON -> PLL_ON in 1us and starts transmitting from PLL_ON so there is no PLL lock to wait for
+static void _rf_tx_start() {
+	if (_rf_tx_busy || !_rf_tx_count)
+		return;
+
+	uint8_t status;
+	while ((status = TRX_STATUS & 0x1F) == STATE_TRANSITION_IN_PROGRESS)
+		;	// a state change takes about 1us and raises no interrupt
+
+	// a frame being received would be lost; the RX_END interrupt (or the TX_END of an acknowledgement) starts it instead
+	// in RX_AACK_ON a frame for another address raises no RX_END, so the TIMER4 compare also starts it
+	if ((status == BUSY_RX) || (status == BUSY_RX_AACK)) {
+		_rf_tx_wait();
+		return;
+	}
 
-	RF_LOAD_FRAME();
+	// after a transmission the radio is already in PLL_ON or TX_ARET_ON
+	if ((status != PLL_ON) && (status != TX_ARET_ON)) {
+		_rf_state(CMD_PLL_ON);
 
-	// The start of frame buffer - TRXFBST is the first byte of the 128 byte frame. It should contain the length of the transmission.
+		// a frame which ended just before the PLL_ON is still in the frame buffer; the RX_END interrupt will call again
+		if (IRQ_STATUS & (1 << RX_END))
+			return;
+	}
+	if (_rf_ext && (status != TX_ARET_ON))
+		_rf_state(CMD_TX_ARET_ON);	// the hardware waits for a clear channel, sends, waits for the ACK, and retries
+
+	_RF_TX_FRAME *frame = &_rf_tx_queue[_rf_tx_head];
+	memcpy((void *)(&TRXFBST + 1), frame->data, frame->length);
+	TRXFBST = frame->length + 2;	// the length includes the CRC
 
-	TRX_STATE |= CMD_TX_START; // initiate TX
-	TRXPR |= (1 << SLPTR);	   // Setting SLPTR high will start the TX.
-	TRXPR &= ~(1 << SLPTR);	   // Setting SLPTR low will end the TX.
+	_rf_tx_busy = true;
+	TRX_STATE = (TRX_STATE & 0xE0) | CMD_TX_START;
+}
 
-	_delay_ms(1); // not sure if this needed
+// the largest payload of a frame in the current mode
+static uint8_t _rf_payload_max() {
+	return _rf_ext ? (RF_FRAME_MAX - RF_MAC_HEADER) : RF_FRAME_MAX;
+}
 
-	// After the byte is sent the radio is set back into the RX waiting state.
-	TRX_STATE = (TRX_STATE & 0xE0) | RX_ON;
+static void _rf_tx_result(uint8_t seq, uint8_t result) {
+	uint8_t shift = (seq & 3) * 2;
+	_rf_tx_results[seq >> 2] = (_rf_tx_results[seq >> 2] & ~(3 << shift)) | (result << shift);
 }
 
+// add a frame to the queue; returns its sequence number or -1 when the queue is full
+// in the extended mode the MAC header is added; the sequence number of the header is the queue sequence number
+static int _rf_tx_queue_frame(uint16_t dest, const uint8_t *data, uint8_t length) {
+	int seq = -1;
+
+	if (length > _rf_payload_max())
+		length = _rf_payload_max();
+
+	CRITICAL_SECTION_START;
+	if (_rf_tx_count < RF_TX_QUEUE_SIZE) {
+		_RF_TX_FRAME *frame = &_rf_tx_queue[(_rf_tx_head + _rf_tx_count) % RF_TX_QUEUE_SIZE];
+		uint8_t *p = frame->data;
+
+		seq = _rf_tx_seq++;
+		if (_rf_ext) {
+			// data frame, PAN ID compression, short destination and source addresses; only unicast asks for an ACK
+			p[0] = 0x41 | ((dest != RF_BROADCAST) ? 0x20 : 0);
+			p[1] = 0x88;
+			p[2] = seq;
+			p[3] = _rf_pan_id;
+			p[4] = _rf_pan_id >> 8;
+			p[5] = dest;
+			p[6] = dest >> 8;
+			p[7] = _rf_address;
+			p[8] = _rf_address >> 8;
+			p += RF_MAC_HEADER;
+		}
+		memcpy(p, data, length);
+		frame->length = (p - frame->data) + length;
+		_rf_tx_result(seq, RF_TX_DONE);
+		_rf_tx_count++;
+		_rf_tx_start();
+	}
+	CRITICAL_SECTION_END;
+	return seq;
+}
 
-// This interrupt is called when radio TX is complete. We'll just
-// ISR(TRX24_TX_END_vect) { }	// not used
+static void _rf_tx_reset() {
+	_rf_tx_wait_stop();
+	_rf_tx_head = 0;
+	_rf_tx_count = 0;
+	_rf_tx_busy = false;
+}
 
+// move the data from the TX buffer into a frame; waits if the queue is full
+void RF_TX_FRAME() {
+	uint8_t frame[RF_FRAME_MAX];
+	uint8_t length = 0;
+	int c;
+
+	while (length < (_rf_payload_max() - 1)) {
+		if ((c = bufferGet(&(_rf_obj.txBuffer))) < 0)
+			break;
+		frame[length++] = c;
+	}
+	frame[length++] = 0;	// the receiver gets a terminated string
+
+	while (_rf_tx_queue_frame(RF_BROADCAST, frame, length) < 0)
+		;	// the TX_END interrupt makes room
+}
+
+// This interrupt is called when radio TX is complete; the radio is back in PLL_ON (or TX_ARET_ON)
+// the next frame is loaded immediately; the radio only returns to receiving when the queue is empty
 ISR(TRX24_TX_END_vect) {
-	//_rf_tx_debug = 0 - _rf_tx_debug; // used to track state for debugging RF issues
+	if (!_rf_tx_busy) {
+		// the end of an acknowledgement sent by the transceiver; a frame which waited for it can start now
+		if (_rf_tx_count)
+			_rf_tx_start();
+		return;
+	}
+
+	if (_rf_ext) {
+		// TRAC_STATUS has the result of the retries
+		uint8_t trac = TRX_STATE & 0xE0;
+		uint8_t result = RF_TX_DONE;
+		if (trac == STAT_NO_ACK)
+			result = RF_TX_NO_ACK;
+		else if (trac == STAT_CHANNEL_ACCESS_FAILURE)
+			result = RF_TX_BUSY;
+		_rf_tx_result(_rf_tx_seq - _rf_tx_count, result);
+	}
+
+	_rf_tx_busy = false;
+	_rf_tx_head = (_rf_tx_head + 1) % RF_TX_QUEUE_SIZE;
+	_rf_tx_count--;
+
+	if (_rf_tx_count)
+		_rf_tx_start();
+	else
+		_rf_rx_on();
+}
+
+// This interrupt is called once the longest frame which held back a transmission has ended
+ISR(TIMER4_COMPA_vect) {
+	_rf_tx_wait_stop();
+	_rf_tx_start();		// waits again if another reception has started
 }
 
 // This interrupt is called when data is received by the radio. It gives us an opportunity to grab signal strength
@@ -235,25 +431,60 @@ ISR(TRX24_RX_START_vect) {
 	//_rf_rx_debug = 0;
 }
 
+// the length of the MAC header of a received data frame and the source address; -1 if it is not a data frame
+// the transceiver has already dropped frames for other addresses and PAN IDs
+static int _rf_mac_header(const uint8_t *p, uint8_t length, uint16_t *src) {
+	if ((length < 3) || ((p[0] & 0x07) != 0x01))
+		return -1;
+
+	uint8_t dst_mode = (p[1] >> 2) & 0x03;
+	uint8_t src_mode = (p[1] >> 6) & 0x03;
+	bool compressed = (p[0] & 0x40);
+	uint8_t header = 3;
+
+	if (dst_mode)
+		header += 2 + ((dst_mode == 2) ? 2 : 8);
+	if (src_mode) {
+		if (!compressed)
+			header += 2;
+		if ((src_mode == 2) && (length >= (header + 2)))
+			*src = p[header] | (p[header + 1] << 8);
+		header += (src_mode == 2) ? 2 : 8;
+	}
+	return (header <= length) ? header : -1;
+}
+
 // This interrupt is called at the end of data receipt.
-// We can now get the data received and store it in the receive buffer.
+// The frame is copied once from the hardware frame buffer into the next free slot.
 ISR(TRX24_RX_END_vect) {
-	// The received signal must be above a certain threshold.
-	if (_rf_signal & RX_CRC_VALID) {
-		uint8_t length;
-		uint8_t frame[RF_RX_BUFFER_SIZE];
-
-		length = TST_RX_LENGTH;						 // first byte is length of received bytes
-		memcpy(&frame[0], (void *)&TRXFBST, length); // remaining bytes are the data
-
-		// there are 2 extra bytes; we know one is the LQI; the other might(?) be the CRC? ... not sure
-		// copy from to our receive buffer
-		for (int i = 0; i < (length - 2); i++) {
-			if (bufferPut(&(_rf_obj.rxBuffer), frame[i]) < 0)
-				_rf_obj.rxOverflow++; // no space in buffer; count overflow
+	// the CRC is only known at the end of the frame
+	if (PHY_RSSI & (1 << RX_CRC_VALID)) {
+		uint8_t length = TST_RX_LENGTH;		// the length includes the 2 byte CRC
+
+		if (_rf_rx_count >= RF_RX_SLOTS) {
+			_rf_obj.rxOverflow++;			// no free slot; the frame is dropped
+		} else if (length >= 2) {
+			RFFRAME *frame = &_rf_rx_slots[(_rf_rx_tail + _rf_rx_count) % RF_RX_SLOTS];
+			int header = 0;
+			frame->src = RF_BROADCAST;
+			if (_rf_ext)
+				header = _rf_mac_header((const uint8_t *)&TRXFBST, length - 2, &frame->src);
+			if (header >= 0) {
+				frame->length = length - 2 - header;
+				frame->rssi = _rf_signal & 0x1F;
+				frame->lqi = (&TRXFBST)[length];	// the LQI follows the frame
+				frame->time = clockMicros();
+				memcpy(frame->data, (const uint8_t *)&TRXFBST + header, frame->length);
+				_rf_rx_count++;
+			}
 		}
 		//_rf_rx_debug = length;
 	}
+
+	// a transmission waits for a frame being received to end; while the transceiver sends its acknowledgement
+	// the status is still BUSY_RX_AACK and the TX_END interrupt of the acknowledgement starts it instead
+	if (_rf_tx_count)
+		_rf_tx_start();
 }
 
 bool _rf_off_state() {
@@ -307,8 +538,12 @@ void rfInit(uint8_t channel) {
 	uint8_t physical_channel = channel + 10;
 
 	// initialize the buffers
-	bufferReset(&(_rf_obj.rxBuffer), rfRxData, RF_RX_BUFFER_SIZE); // initialize the receive buffer
+	_rf_ext = false;	// basic mode until rfAddressSet()
+	_rf_rx_tail = 0;	// empty the receive slots
+	_rf_rx_count = 0;
+	_rf_rx_offset = 0;
 	bufferReset(&(_rf_obj.txBuffer), rfTxData, RF_TX_BUFFER_SIZE); // initialize the transmit buffer
+	_rf_tx_reset();
 
 	//cli(); // prevent interrupts
 
@@ -382,6 +617,7 @@ void rfTerm() {
 	_rf_obj.txIdle = true;
 
 	_rf_off_state();
+	_rf_tx_reset();
 
 	TRXPR = 1 << SLPTR; // if the transceiver state is TRX_OFF then sleep
 
@@ -404,6 +640,47 @@ uint8_t rfInited() {
 
 
 
+/* ---
+#### bool rfAddressSet(uint16_t pan_id, uint16_t address, uint8_t frame_retries, uint8_t csma_retries)
+
+Use the extended operating mode of the transceiver with the `pan_id` network and the short `address` of this SRXE.
+
+Received frames must be for this `address` _(or `RF_BROADCAST`)_ and `pan_id`; the transceiver sends the acknowledgements.
+A frame from `rfSendTo()` is sent up to `frame_retries` _(0 .. 15)_ more times until it is acknowledged.
+Before each attempt the transceiver waits for a clear channel up to `csma_retries` _(0 .. 5)_ more times.
+
+Waits for any queued frames to be sent. Returns `false` if the RF transceiver is not inited.
+Use `rfInit()` to return to the basic mode.
+--- */
+bool rfAddressSet(uint16_t pan_id, uint16_t address, uint8_t frame_retries, uint8_t csma_retries) {
+	if (!_rf_obj.inited)
+		return false;
+	while (_rf_tx_count)
+		;
+
+	if (frame_retries > 15)
+		frame_retries = 15;
+	if (csma_retries > 5)
+		csma_retries = 5;
+
+	CRITICAL_SECTION_START;
+	_rf_state(CMD_PLL_ON);
+
+	_rf_pan_id = pan_id;
+	_rf_address = address;
+	PAN_ID_0 = pan_id;
+	PAN_ID_1 = pan_id >> 8;
+	SHORT_ADDR_0 = address;
+	SHORT_ADDR_1 = address >> 8;
+	XAH_CTRL_0 = (frame_retries << MAX_FRAME_RETRIES0) | (csma_retries << MAX_CSMA_RETRIES0);
+	CSMA_SEED_0 = address;	// the random backoff of each SRXE should differ
+
+	_rf_ext = true;
+	_rf_rx_on();
+	CRITICAL_SECTION_END;
+	return true;
+}
+
 /* ---
 ### Helper Functions
 --- */
@@ -414,9 +691,13 @@ uint8_t rfInited() {
 Flush any pending data in the receive buffer (useful if you are waiting on a specifc message and have detected it is corrupted).
 --- */
 void rfFlushReceiveBuffer() {
-	// flush all data from receive buffer
-	bufferFlush(&(_rf_obj.rxBuffer));
+	// flush all received frames
+	CRITICAL_SECTION_START;
+	_rf_rx_tail = (_rf_rx_tail + _rf_rx_count) % RF_RX_SLOTS;
+	_rf_rx_count = 0;
+	_rf_rx_offset = 0;
 	_rf_obj.rxOverflow = 0;
+	CRITICAL_SECTION_END;
 }
 
 
@@ -427,14 +708,47 @@ void rfFlushReceiveBuffer() {
  This is a good indication that subsequent data is unreliable.
 --- */
 uint8_t rfReceiveBufferOverflow() {
-	return _rf_obj.rxOverflow; // no space in buffer; count overflow
+	return _rf_obj.rxOverflow; // number of frames dropped because there was no free slot
 }
 
 
 /* ---
 ### Read Functions
+
+Received frames are kept in `RF_RX_SLOTS` _(default 4)_ slots. A frame is read in place with `rfRecvFrame()`
+and its slot is given back with `rfReleaseFrame()`. A frame which arrives when all of the slots are in use is dropped.
+
+The byte stream functions read the same frames; the bytes of each frame follow the bytes of the previous frame.
+Do not mix the two styles while a frame is partially read.
 --- */
 
+/* ---
+#### RFFRAME *rfRecvFrame()
+
+Return the oldest received frame or `NULL` if there is none.
+The same frame is returned until it is released with `rfReleaseFrame()`.
+--- */
+RFFRAME *rfRecvFrame() {
+	if (!_rf_obj.inited || !_rf_rx_count)
+		return NULL;
+	return &_rf_rx_slots[_rf_rx_tail];
+}
+
+/* ---
+#### void rfReleaseFrame()
+
+Release the frame from `rfRecvFrame()` so its slot may receive a new frame.
+--- */
+void rfReleaseFrame() {
+	CRITICAL_SECTION_START;
+	if (_rf_rx_count) {
+		_rf_rx_tail = (_rf_rx_tail + 1) % RF_RX_SLOTS;
+		_rf_rx_count--;
+	}
+	_rf_rx_offset = 0;
+	CRITICAL_SECTION_END;
+}
+
 /* ---
 #### int rfAvailable()
 
@@ -443,7 +757,12 @@ Return the number of unread bytes in receive buffer.
 int rfAvailable() {
 	if (!_rf_obj.inited)
 		return -1;
-	return _rf_obj.rxBuffer.length;
+
+	int count = -_rf_rx_offset;
+	uint8_t frames = _rf_rx_count;
+	for (uint8_t i = 0; i < frames; i++)
+		count += _rf_rx_slots[(_rf_rx_tail + i) % RF_RX_SLOTS].length;
+	return count;
 }
 
 
@@ -453,9 +772,18 @@ int rfAvailable() {
 Return a single byte from the receive buffer (getchar-style) returns -1 if no byte is available.
 --- */
 int rfGetByte() {
-	if (!_rf_obj.inited)
-		return -1;
-	return bufferGet(&(_rf_obj.rxBuffer));
+	RFFRAME *frame;
+
+	while ((frame = rfRecvFrame())) {
+		if (_rf_rx_offset < frame->length) {
+			int c = frame->data[_rf_rx_offset++];
+			if (_rf_rx_offset >= frame->length)
+				rfReleaseFrame();
+			return c;
+		}
+		rfReleaseFrame();	// an empty frame
+	}
+	return -1;
 }
 
 
@@ -471,11 +799,17 @@ int rfGetBuffer(uint8_t *data, uint8_t maxlen) {
 
 	memset(data, 0, maxlen);
 
-	int avail = rfAvailable();
-	if (avail > maxlen)
-		avail = maxlen;
-	for (int i = 0; i < avail; i++) {
-		data[i] = bufferGet(&(_rf_obj.rxBuffer));
+	int avail = 0;
+	RFFRAME *frame;
+	while ((avail < maxlen) && (frame = rfRecvFrame())) {
+		uint8_t count = frame->length - _rf_rx_offset;
+		if (count > (maxlen - avail))
+			count = maxlen - avail;
+		memcpy(&data[avail], &frame->data[_rf_rx_offset], count);
+		avail += count;
+		_rf_rx_offset += count;
+		if (_rf_rx_offset >= frame->length)
+			rfReleaseFrame();
 	}
 	return avail;
 }
@@ -489,6 +823,7 @@ int rfGetBuffer(uint8_t *data, uint8_t maxlen) {
 #### void rfTransmitNow()
 
 Transmit any data which hs been put into the TX buffer.
+The data is queued as a frame; this only waits if the frame queue is full.
 
 This function is often used after a series of `rfPutByte()`, `rfPutBuffer()`, or `rfPutString()` calls.
 to transmit all of the data.
@@ -500,6 +835,67 @@ void rfTransmitNow() {
 	RF_TX_FRAME();
 }
 
+/* ---
+#### int rfSendFrame(const uint8_t *data, uint8_t len)
+
+Queue `len` bytes _(up to `RF_FRAME_MAX`, less `RF_MAC_HEADER` after `rfAddressSet()`)_ to be sent as a single frame and return immediately.
+The frame is for every SRXE on the channel and is not acknowledged.
+
+Returns the sequence number of the frame _(0 .. 255)_ for `rfSendStatus()`,
+or -1 if the queue is full or the RF transceiver is not inited.
+--- */
+int rfSendFrame(const uint8_t *data, uint8_t len) {
+	if (!_rf_obj.inited)
+		return -1;
+	return _rf_tx_queue_frame(RF_BROADCAST, data, len);
+}
+
+/* ---
+#### int rfSendTo(uint16_t address, const uint8_t *data, uint8_t len)
+
+Queue a frame for the SRXE with the short `address`; the same as `rfSendFrame()` otherwise.
+The transceiver retransmits the frame until it is acknowledged; `rfSendStatus()` reports the result.
+
+Requires `rfAddressSet()`; returns -1 in the basic mode.
+--- */
+int rfSendTo(uint16_t address, const uint8_t *data, uint8_t len) {
+	if (!_rf_obj.inited || !_rf_ext)
+		return -1;
+	return _rf_tx_queue_frame(address, data, len);
+}
+
+/* ---
+#### uint8_t rfSendStatus(uint8_t seq)
+
+Return the status of the frame with the sequence number `seq`:
+`RF_TX_PENDING` while it is queued or being sent, `RF_TX_DONE` once it is sent _(and acknowledged)_,
+`RF_TX_NO_ACK` if it was never acknowledged, or `RF_TX_BUSY` if the channel was never clear.
+
+The status of a frame is kept until its sequence number is used again, 256 frames later.
+--- */
+uint8_t rfSendStatus(uint8_t seq) {
+	uint8_t status;
+
+	CRITICAL_SECTION_START;
+	_rf_tx_start();
+	// the queued frames are the most recent sequence numbers
+	if ((uint8_t)(_rf_tx_seq - seq - 1) < _rf_tx_count)
+		status = RF_TX_PENDING;
+	else
+		status = (_rf_tx_results[seq >> 2] >> ((seq & 3) * 2)) & 3;
+	CRITICAL_SECTION_END;
+	return status;
+}
+
+/* ---
+#### uint8_t rfSendQueued()
+
+Return the number of frames which are queued or being sent.
+--- */
+uint8_t rfSendQueued() {
+	return _rf_tx_count;
+}
+
 /* ---
 #### int rfPutByte(uint8_t txData)
 
@@ -536,8 +932,12 @@ int rfPutBuffer(uint8_t *data, uint8_t len) {
 	if (!_rf_obj.inited)
 		return -1;
 
-	for (uint8_t i = 0; i < len; i++)
-		bufferPut(&(_rf_obj.txBuffer), data[i]);	// bufferPut() will ignore any bytes that will not fit
+	for (uint8_t i = 0; i < len; i++) {
+		// a full buffer is sent as a frame rather than losing the rest of the data
+		if (_rf_obj.txBuffer.length >= (HW_FRAME_TX_SIZE))
+			RF_TX_FRAME();
+		bufferPut(&(_rf_obj.txBuffer), data[i]);
+	}
 
 	if (_rf_obj.txBuffer.length >= (HW_FRAME_TX_SIZE)) {
 		RF_TX_FRAME();
@@ -0,0 +1,487 @@
+/* ************************************************************************************
+* File:    rfstar.h
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+
+### RF Star
+**A Base Station Collecting Answers from a Room of Responders**
+
+When many SRXE send at once, most of the frames collide. When `RF_STAR` is defined, one SRXE _(the base)_
+schedules the others _(the responders)_ so each has its own time to send.
+
+The base sends a beacon at the start of each round. The beacon has the current question,
+a bitmap of the responders whose answer has arrived, and the slots given to responders which have just joined.
+After the beacon come one slot of `RF_STAR_SLOT_US` _(default 800us)_ for each responder in the roster whose answer
+has not arrived, then the contention slots. A responder with an answer which has not arrived sends it in its own slot.
+A responder which is not in the roster sends its ID _(and its answer, if it has one)_ in a randomly chosen contention slot.
+When two join at once, both try again later with twice the choice of slots, up to four times the contention slots.
+
+The roster holds up to `RF_STAR_SLOTS` _(default 128)_ responders. A responder is known by a 6 character ID;
+`eepromSignature()` is a good choice.
+
+The protocol is a set of state functions which build and read frames without using the radio;
+`files/srxe_emulator/rf_star_sim.cpp` runs them against a simulated radio.
+`rfStarBaseRun()` and `rfStarNodeRun()` connect them to the RF transceiver.
+
+A typical use:
+```C
+// the base
+rfStarBaseInit(&base, 0x5A, 8);
+rfStarBaseQuestion(&base);
+while (rfStarBaseAnswered(&base) < base.count)
+	rfStarBaseRun(&base);
+
+// a responder
+rfStarNodeInit(&node, eepromSignature());
+while (true) {
+	rfStarNodeRun(&node);
+	if (key)
+		rfStarNodeAnswer(&node, key);
+}
+```
+
+**Notes:**
+The RF transceiver must be in the basic mode _(see `rfInit()`)_; the beacons and answers are not acknowledged.
+A round with 100 responders and no answers is about 90ms.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_RFSTAR_
+#define __SRXE_RFSTAR_
+
+#ifdef RF_STAR
+
+#include "rf.h"
+#include "clock.h"
+
+#ifndef RF_STAR_SLOTS
+#define RF_STAR_SLOTS 128
+#endif
+
+#ifndef RF_STAR_SLOT_US
+#define RF_STAR_SLOT_US 800		// a join frame is 576us on the air; the rest is the guard for timing errors
+#endif
+
+#ifndef RF_STAR_GAP_US
+#define RF_STAR_GAP_US 500		// from the end of the beacon to the first slot
+#endif
+
+#ifndef RF_STAR_ANNOUNCE
+#define RF_STAR_ANNOUNCE 12		// new slots in each beacon
+#endif
+
+#define RF_STAR_ID_SIZE		6
+#define RF_STAR_NONE		0xFF
+
+// the first byte of each frame
+#define _RF_STAR_BEACON		0xC0	// type, net, round, question, count, contention, pending, answered bitmap, assignments, (slot, id) x assignments
+#define _RF_STAR_ANSWER		0xC1	// type, net, slot, question, answer
+#define _RF_STAR_JOIN		0xC2	// type, net, question, answer, id
+
+#define _RF_STAR_BITMAP		7		// the offset of the bitmap in a beacon
+#define _RF_STAR_QUEUE		32		// joins waiting to be announced
+#define _RF_STAR_BACKOFF	4		// the largest join window in multiples of the contention slots
+
+/* ---
+#### RFSTAR_BASE
+
+The state of the base.
+```C
+*/
+typedef struct {
+	uint8_t net;								// tells this room from the one next door
+	uint8_t round;
+	uint8_t question;
+	uint8_t count;								// responders in the roster; the slots 0 .. count - 1
+	uint8_t contention;							// contention slots in each round
+	char roster[RF_STAR_SLOTS][RF_STAR_ID_SIZE];
+	uint8_t answers[RF_STAR_SLOTS];				// the answer to the current question or RF_STAR_NONE
+	uint8_t queue[_RF_STAR_QUEUE];				// slots to announce
+	uint8_t queue_head, queue_count;
+} RFSTAR_BASE;
+/*
+```
+--- */
+
+/* ---
+#### RFSTAR_NODE
+
+The state of a responder.
+```C
+*/
+typedef struct {
+	char id[RF_STAR_ID_SIZE];
+	uint8_t net;								// RF_STAR_NONE until the first beacon
+	uint8_t slot;								// RF_STAR_NONE until the base gives a slot
+	uint8_t question;
+	uint8_t answer;								// RF_STAR_NONE until there is an answer to the current question
+	bool answered;								// the base has the answer
+	bool joining;								// a join was sent in the last round
+	uint16_t window;							// the number of slots a join is chosen from
+	uint16_t random;
+} RFSTAR_NODE;
+/*
+```
+--- */
+
+// the time a frame with a payload of `length` bytes is on the air: preamble, SFD, length, payload, and CRC at 32us per byte
+static uint32_t _rf_star_air_us(uint8_t length) {
+	return (uint32_t)(6 + length + 2) * 32;
+}
+
+/* ---
+#### uint32_t rfStarRoundUs(uint8_t count, uint8_t contention)
+
+Return the time from the end of a beacon to the end of its round in microseconds.
+`count` is the number of responders in the roster which have not answered.
+--- */
+uint32_t rfStarRoundUs(uint8_t count, uint8_t contention) {
+	return RF_STAR_GAP_US + ((uint32_t)count + contention) * RF_STAR_SLOT_US;
+}
+
+
+// --------------------------------------------------------------------------
+// base
+// --------------------------------------------------------------------------
+
+// the slot of an ID in the roster or RF_STAR_NONE
+static uint8_t _rf_star_find(RFSTAR_BASE *base, const uint8_t *id) {
+	for (uint8_t i = 0; i < base->count; i++) {
+		if (memcmp(base->roster[i], id, RF_STAR_ID_SIZE) == 0)
+			return i;
+	}
+	return RF_STAR_NONE;
+}
+
+static void _rf_star_announce(RFSTAR_BASE *base, uint8_t slot) {
+	for (uint8_t i = 0; i < base->queue_count; i++) {
+		if (base->queue[(base->queue_head + i) % _RF_STAR_QUEUE] == slot)
+			return;
+	}
+	// a slot which does not fit is announced when the responder joins again
+	if (base->queue_count < _RF_STAR_QUEUE)
+		base->queue[(base->queue_head + base->queue_count++) % _RF_STAR_QUEUE] = slot;
+}
+
+/* ---
+#### void rfStarBaseInit(RFSTAR_BASE *base, uint8_t net, uint8_t contention)
+
+Start a base with an empty roster. `net` is any number which differs from the other bases in range.
+`contention` is the number of contention slots in each round _(1 .. 64)_.
+--- */
+void rfStarBaseInit(RFSTAR_BASE *base, uint8_t net, uint8_t contention) {
+	memset(base, 0, sizeof(RFSTAR_BASE));
+	memset(base->answers, RF_STAR_NONE, sizeof(base->answers));
+	base->net = net;
+	base->contention = (contention < 1) ? 1 : ((contention > 64) ? 64 : contention);
+}
+
+/* ---
+#### void rfStarBaseQuestion(RFSTAR_BASE *base)
+
+Start a new question; the answers to the previous question are cleared.
+--- */
+void rfStarBaseQuestion(RFSTAR_BASE *base) {
+	base->question++;
+	memset(base->answers, RF_STAR_NONE, sizeof(base->answers));
+}
+
+/* ---
+#### uint8_t rfStarBaseBeacon(RFSTAR_BASE *base, uint8_t *frame)
+
+Build the beacon which starts the next round in `frame` _(at least `RF_FRAME_MAX` bytes)_ and return its length.
+The round lasts `rfStarRoundUs()` after the end of the beacon.
+--- */
+uint8_t rfStarBaseBeacon(RFSTAR_BASE *base, uint8_t *frame) {
+	uint8_t bytes = (base->count + 7) / 8;
+	uint8_t *p = &frame[_RF_STAR_BITMAP];
+
+	frame[0] = _RF_STAR_BEACON;
+	frame[1] = base->net;
+	frame[2] = ++base->round;
+	frame[3] = base->question;
+	frame[4] = base->count;
+	frame[5] = base->contention;
+
+	memset(p, 0, bytes);
+	for (uint8_t i = 0; i < base->count; i++) {
+		if (base->answers[i] != RF_STAR_NONE)
+			p[i >> 3] |= (1 << (i & 7));
+	}
+	p += bytes;
+
+	uint8_t *assignments = p++;
+	*assignments = 0;
+	while (base->queue_count && (*assignments < RF_STAR_ANNOUNCE)) {
+		uint8_t slot = base->queue[base->queue_head];
+		base->queue_head = (base->queue_head + 1) % _RF_STAR_QUEUE;
+		base->queue_count--;
+		*p++ = slot;
+		memcpy(p, base->roster[slot], RF_STAR_ID_SIZE);
+		p += RF_STAR_ID_SIZE;
+		(*assignments)++;
+	}
+	frame[6] = base->queue_count;	// joins which have arrived but wait for a later beacon
+	return p - frame;
+}
+
+/* ---
+#### bool rfStarBaseFrame(RFSTAR_BASE *base, const uint8_t *frame, uint8_t length)
+
+Give the base a received frame. Answers are recorded and responders which join are added to the roster.
+Returns `true` if the frame was for this base.
+--- */
+bool rfStarBaseFrame(RFSTAR_BASE *base, const uint8_t *frame, uint8_t length) {
+	if ((length < 5) || (frame[1] != base->net))
+		return false;
+
+	if (frame[0] == _RF_STAR_ANSWER) {
+		if ((frame[2] < base->count) && (frame[3] == base->question))
+			base->answers[frame[2]] = frame[4];
+		return true;
+	}
+
+	if ((frame[0] == _RF_STAR_JOIN) && (length >= (4 + RF_STAR_ID_SIZE))) {
+		const uint8_t *id = &frame[4];
+		uint8_t slot = _rf_star_find(base, id);
+		if (slot == RF_STAR_NONE) {
+			if (base->count >= RF_STAR_SLOTS)
+				return true;	// the roster is full
+			slot = base->count++;
+			memcpy(base->roster[slot], id, RF_STAR_ID_SIZE);
+		}
+		// a responder which joins again missed the beacon with its slot
+		_rf_star_announce(base, slot);
+		if ((frame[2] == base->question) && (frame[3] != RF_STAR_NONE))
+			base->answers[slot] = frame[3];
+		return true;
+	}
+	return false;
+}
+
+/* ---
+#### uint8_t rfStarBaseAnswered(RFSTAR_BASE *base)
+
+Return the number of responders in the roster which have answered the current question.
+--- */
+uint8_t rfStarBaseAnswered(RFSTAR_BASE *base) {
+	uint8_t count = 0;
+	for (uint8_t i = 0; i < base->count; i++) {
+		if (base->answers[i] != RF_STAR_NONE)
+			count++;
+	}
+	return count;
+}
+
+
+// --------------------------------------------------------------------------
+// responder
+// --------------------------------------------------------------------------
+
+// a 16 bit xorshift; each responder starts from its ID so they choose different contention slots
+static uint16_t _rf_star_random(RFSTAR_NODE *node) {
+	uint16_t x = node->random;
+	x ^= x << 7;
+	x ^= x >> 9;
+	x ^= x << 8;
+	node->random = x;
+	return x;
+}
+
+/* ---
+#### void rfStarNodeInit(RFSTAR_NODE *node, const char *id)
+
+Start a responder with a 6 character `id` _(eg: `eepromSignature()`)_. It joins the first base it hears.
+--- */
+void rfStarNodeInit(RFSTAR_NODE *node, const char *id) {
+	memset(node, 0, sizeof(RFSTAR_NODE));
+	memcpy(node->id, id, RF_STAR_ID_SIZE);
+	node->net = RF_STAR_NONE;
+	node->slot = RF_STAR_NONE;
+	node->answer = RF_STAR_NONE;
+	node->random = 0xACE1;
+	for (uint8_t i = 0; i < RF_STAR_ID_SIZE; i++)
+		node->random = (node->random * 31) + (uint8_t)id[i];
+	if (!node->random)
+		node->random = 1;
+}
+
+/* ---
+#### void rfStarNodeAnswer(RFSTAR_NODE *node, uint8_t answer)
+
+Set the answer _(0 .. 254)_ to the current question. It is sent in the next round.
+--- */
+void rfStarNodeAnswer(RFSTAR_NODE *node, uint8_t answer) {
+	if (answer == RF_STAR_NONE)
+		return;
+	node->answer = answer;
+	node->answered = false;
+}
+
+/* ---
+#### uint8_t rfStarNodeBeacon(RFSTAR_NODE *node, const uint8_t *beacon, uint8_t length, uint8_t *reply, uint32_t *delay_us)
+
+Give the responder a received beacon. If the responder has something to send in this round,
+the frame is built in `reply` _(at least 16 bytes)_, `delay_us` is set to the time from the end of the beacon to send it,
+and its length is returned. Otherwise 0 is returned.
+--- */
+uint8_t rfStarNodeBeacon(RFSTAR_NODE *node, const uint8_t *beacon, uint8_t length, uint8_t *reply, uint32_t *delay_us) {
+	if ((length < (_RF_STAR_BITMAP + 1)) || (beacon[0] != _RF_STAR_BEACON))
+		return 0;
+	if (node->net == RF_STAR_NONE)
+		node->net = beacon[1];
+	else if (beacon[1] != node->net)
+		return 0;
+
+	uint8_t question = beacon[3];
+	uint8_t count = beacon[4];
+	uint8_t contention = beacon[5];
+	uint8_t pending = beacon[6];
+	uint8_t bytes = (count + 7) / 8;
+	if (length < (_RF_STAR_BITMAP + bytes + 1))
+		return 0;
+
+	if (question != node->question) {
+		node->question = question;
+		node->answer = RF_STAR_NONE;
+		node->answered = false;
+	}
+
+	// look for a slot for this responder
+	const uint8_t *p = &beacon[_RF_STAR_BITMAP + bytes];
+	uint8_t assignments = *p++;
+	for (uint8_t i = 0; (i < assignments) && ((p + 1 + RF_STAR_ID_SIZE) <= (beacon + length)); i++, p += 1 + RF_STAR_ID_SIZE) {
+		if (memcmp(p + 1, node->id, RF_STAR_ID_SIZE) == 0)
+			node->slot = *p;
+	}
+
+	// the slots of the responders which have answered are left out of the round; a slot given by this beacon counts
+	uint8_t open = 0, before = 0;
+	for (uint8_t i = 0; i < count; i++) {
+		if (!(beacon[_RF_STAR_BITMAP + (i >> 3)] & (1 << (i & 7)))) {
+			if (i < node->slot)
+				before++;
+			open++;
+		}
+	}
+
+	if ((node->slot != RF_STAR_NONE) && (node->slot < count)) {
+		node->joining = false;
+		node->window = contention;
+		if (beacon[_RF_STAR_BITMAP + (node->slot >> 3)] & (1 << (node->slot & 7)))
+			node->answered = true;
+		if ((node->answer == RF_STAR_NONE) || node->answered)
+			return 0;
+
+		reply[0] = _RF_STAR_ANSWER;
+		reply[1] = node->net;
+		reply[2] = node->slot;
+		reply[3] = node->question;
+		reply[4] = node->answer;
+		*delay_us = RF_STAR_GAP_US + (uint32_t)before * RF_STAR_SLOT_US;
+		return 5;
+	}
+
+	// not in the roster; while the base has joins still to announce, the last join may be one of them
+	if (node->joining && pending)
+		return 0;
+
+	// a join which was not answered collided so the next choice is from twice as many slots;
+	// a larger window leaves the last few responders sitting out most rounds
+	if (node->joining)
+		node->window *= 2;
+	if (node->window > ((uint16_t)contention * _RF_STAR_BACKOFF))
+		node->window = (uint16_t)contention * _RF_STAR_BACKOFF;
+	if (node->window < contention)
+		node->window = contention;
+	node->joining = false;
+
+	uint16_t choice = _rf_star_random(node) % node->window;
+	if (choice >= contention)
+		return 0;	// sit this round out
+
+	node->joining = true;
+	reply[0] = _RF_STAR_JOIN;
+	reply[1] = node->net;
+	reply[2] = node->question;
+	reply[3] = node->answer;
+	memcpy(&reply[4], node->id, RF_STAR_ID_SIZE);
+	*delay_us = RF_STAR_GAP_US + ((uint32_t)open + choice) * RF_STAR_SLOT_US;
+	return 4 + RF_STAR_ID_SIZE;
+}
+
+
+// --------------------------------------------------------------------------
+// radio
+// --------------------------------------------------------------------------
+
+static uint32_t _rf_star_due;			// base: the start of the next round; responder: when to send the reply
+static uint8_t _rf_star_reply[4 + RF_STAR_ID_SIZE];
+static uint8_t _rf_star_reply_length;
+static bool _rf_star_started;
+
+/* ---
+#### void rfStarBaseRun(RFSTAR_BASE *base)
+
+Run the base with the RF transceiver: send a beacon at the start of each round and give the received frames to the base.
+Call this often; it does not wait.
+--- */
+void rfStarBaseRun(RFSTAR_BASE *base) {
+	RFFRAME *frame;
+
+	while ((frame = rfRecvFrame())) {
+		rfStarBaseFrame(base, frame->data, frame->length);
+		rfReleaseFrame();
+	}
+
+	uint32_t now = clockMicros();
+	if (_rf_star_started && ((int32_t)(now - _rf_star_due) < 0))
+		return;
+
+	uint8_t beacon[RF_FRAME_MAX];
+	uint8_t length = rfStarBaseBeacon(base, beacon);
+	if (rfSendFrame(beacon, length) < 0)
+		return;
+	_rf_star_started = true;
+	_rf_star_due = now + _rf_star_air_us(length) + rfStarRoundUs(base->count - rfStarBaseAnswered(base), base->contention);
+}
+
+/* ---
+#### void rfStarNodeRun(RFSTAR_NODE *node)
+
+Run a responder with the RF transceiver: read the beacons and send the answer or join at the time of its slot.
+Call this often; a reply which would be too late for its slot is not sent.
+--- */
+void rfStarNodeRun(RFSTAR_NODE *node) {
+	RFFRAME *frame;
+	uint32_t delay_us;
+
+	while ((frame = rfRecvFrame())) {
+		uint8_t length = rfStarNodeBeacon(node, frame->data, frame->length, _rf_star_reply, &delay_us);
+		if (length) {
+			_rf_star_reply_length = length;
+			_rf_star_due = frame->time + delay_us;
+		}
+		rfReleaseFrame();
+	}
+
+	if (!_rf_star_reply_length)
+		return;
+
+	int32_t late = (int32_t)(clockMicros() - _rf_star_due);
+	if (late < 0)
+		return;
+	if (late < (int32_t)(RF_STAR_SLOT_US - _rf_star_air_us(_rf_star_reply_length)))
+		rfSendFrame(_rf_star_reply, _rf_star_reply_length);
+	_rf_star_reply_length = 0;
+}
+
+#endif // RF_STAR
+#endif // __SRXE_RFSTAR_
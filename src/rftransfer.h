@@ -0,0 +1,407 @@
+/* ************************************************************************************
+* File:    rftransfer.h
+* Date:    2026.10.16
+* Author:  Bradan Lane Studio
+*
+* This content may be redistributed and/or modified as outlined under the MIT License
+*
+* ************************************************************************************/
+
+/* ---
+
+### RF Transfer
+**Messages Larger Than a Frame**
+
+A frame holds at most `RF_FRAME_MAX` bytes. When `RF_TRANSFER` is defined, a message of up to several KB
+_(eg: a sector of the FLASH or a bitmap)_ may be sent as a series of numbered fragments and put back together by the receiver.
+
+The sender keeps up to a window of fragments in flight. The last fragment of each window asks the receiver for its status;
+the receiver answers with a bitmap of the fragments it has and the sender only sends the missing fragments again.
+If no status arrives within `RF_TRANSFER_TIMEOUT` ms _(default 50)_ the sender asks again, up to `RF_TRANSFER_RETRIES` _(default 8)_ times.
+Until a receiver has answered, the sender asks by sending the first fragment again; a receiver which missed it could not answer.
+A receiver which has heard nothing from the sender for `RF_TRANSFER_INACTIVE` ms _(default 500)_ gives up.
+
+A message has at most `RF_TRANSFER_FRAGMENTS` _(default 64)_ fragments. Each fragment carries `RF_FRAME_MAX - 7` bytes
+_(less `RF_MAC_HEADER` after `rfAddressSet()`)_ so the largest message is about 7.5KB.
+
+A typical use:
+```C
+// the sender
+rfTransferSend(RF_BROADCAST, sector, 4096);
+while (rfTransferPoll() == RF_TRANSFER_BUSY)
+	;
+
+// the receiver
+rfTransferReceive(buffer, sizeof(buffer));
+while (rfTransferPoll() == RF_TRANSFER_BUSY)
+	;
+length = rfTransferLength();
+```
+
+**Notes:**
+A transfer has one receiver. The sender follows the first receiver whose status arrives and ignores any other;
+other SRXEs may hear the fragments, even of a transfer sent to `RF_BROADCAST`, but are not sure to get all of them.
+While a transfer is active, `rfTransferPoll()` reads every received frame; frames which are not part of the transfer are dropped.
+A window larger than `RF_RX_SLOTS` may overrun the receiver; the missing fragments are then sent again.
+Use `rfTransferRate()` to compare window sizes.
+
+--------------------------------------------------------------------------
+--- */
+
+#ifndef __SRXE_RFTRANSFER_
+#define __SRXE_RFTRANSFER_
+
+#ifdef RF_TRANSFER
+
+#include "rf.h"
+#include "clock.h"
+
+#ifndef RF_TRANSFER_FRAGMENTS
+#define RF_TRANSFER_FRAGMENTS 64
+#endif
+
+#ifndef RF_TRANSFER_WINDOW
+#define RF_TRANSFER_WINDOW 4
+#endif
+
+#ifndef RF_TRANSFER_TIMEOUT
+#define RF_TRANSFER_TIMEOUT 50
+#endif
+
+#ifndef RF_TRANSFER_RETRIES
+#define RF_TRANSFER_RETRIES 8
+#endif
+
+#ifndef RF_TRANSFER_INACTIVE
+#define RF_TRANSFER_INACTIVE (RF_TRANSFER_TIMEOUT * (RF_TRANSFER_RETRIES + 2))	// a little longer than the sender keeps asking
+#endif
+
+// the state from rfTransferPoll()
+#define RF_TRANSFER_IDLE	0
+#define RF_TRANSFER_BUSY	1
+#define RF_TRANSFER_DONE	2
+#define RF_TRANSFER_FAILED	3
+
+// the first byte of each transfer frame
+#define _RF_XFER_DATA		0xB0	// a fragment: type, id, index, count, fragment size, length (2), data
+#define _RF_XFER_DATA_POLL	0xB1	// a fragment which also asks for the status
+#define _RF_XFER_POLL		0xB2	// ask for the status: type, id, tag (2) or 0 for any receiver
+#define _RF_XFER_STATUS		0xB3	// the fragments received: type, id, tag (2), bitmap
+
+#define _RF_XFER_HEADER		7
+#define _RF_XFER_MAP_SIZE	((RF_TRANSFER_FRAGMENTS + 7) / 8)
+
+#define _RF_XFER_SEND		1
+#define _RF_XFER_RECEIVE	2
+
+typedef struct {
+	uint8_t role;
+	uint8_t state;
+	uint8_t id;
+	uint8_t *data;
+	uint16_t length;				// the message length; for the receiver, the size of the buffer until the first fragment
+	uint16_t peer;					// the other SRXE after rfAddressSet(), otherwise RF_BROADCAST
+	uint16_t tag;					// the receiver of this transfer; 0 until the sender has its first status
+	uint8_t count;					// fragments in the message
+	uint8_t fragment;				// bytes in each fragment except the last
+	uint8_t map[_RF_XFER_MAP_SIZE];	// the fragments the receiver has
+	uint8_t next;					// sender: the next fragment to consider
+	uint8_t in_flight;				// sender: fragments sent since the last status
+	uint8_t retries;
+	uint32_t poll_time;				// sender: when the status was last asked for; receiver: when the sender was last heard
+	uint32_t start;
+} _RF_TRANSFER;
+
+static _RF_TRANSFER _rf_xfer;
+static uint8_t _rf_xfer_window = RF_TRANSFER_WINDOW;
+static uint8_t _rf_xfer_id;
+static uint32_t _rf_xfer_ms;		// the duration and size of the last transfer which finished
+static uint16_t _rf_xfer_bytes;
+
+static bool _rf_xfer_has(uint8_t index) {
+	return _rf_xfer.map[index >> 3] & (1 << (index & 7));
+}
+
+static void _rf_xfer_send_frame(const uint8_t *frame, uint8_t length) {
+	// the transfer waits for room in the TX queue rather than losing a frame
+	if (_rf_xfer.peer == RF_BROADCAST) {
+		while (rfSendFrame(frame, length) < 0)
+			;
+	} else {
+		while (rfSendTo(_rf_xfer.peer, frame, length) < 0)
+			;
+	}
+}
+
+static void _rf_xfer_finish(uint8_t state) {
+	_rf_xfer.state = state;
+	if (state == RF_TRANSFER_DONE) {
+		_rf_xfer_ms = clockMillis() - _rf_xfer.start;
+		_rf_xfer_bytes = _rf_xfer.length;
+	}
+}
+
+// send one fragment; the last fragment of a window asks for the status
+static void _rf_xfer_send_fragment(uint8_t index, bool poll) {
+	uint8_t frame[RF_FRAME_MAX];
+	uint16_t offset = (uint16_t)index * _rf_xfer.fragment;
+	uint8_t size = ((_rf_xfer.length - offset) < _rf_xfer.fragment) ? (_rf_xfer.length - offset) : _rf_xfer.fragment;
+
+	frame[0] = poll ? _RF_XFER_DATA_POLL : _RF_XFER_DATA;
+	frame[1] = _rf_xfer.id;
+	frame[2] = index;
+	frame[3] = _rf_xfer.count;
+	frame[4] = _rf_xfer.fragment;
+	frame[5] = _rf_xfer.length;
+	frame[6] = _rf_xfer.length >> 8;
+	memcpy(&frame[_RF_XFER_HEADER], &_rf_xfer.data[offset], size);
+	_rf_xfer_send_frame(frame, _RF_XFER_HEADER + size);
+}
+
+static void _rf_xfer_send_status() {
+	uint8_t frame[4 + _RF_XFER_MAP_SIZE];
+	frame[0] = _RF_XFER_STATUS;
+	frame[1] = _rf_xfer.id;
+	frame[2] = _rf_xfer.tag;
+	frame[3] = _rf_xfer.tag >> 8;
+	memcpy(&frame[4], _rf_xfer.map, _RF_XFER_MAP_SIZE);
+	_rf_xfer_send_frame(frame, sizeof(frame));
+}
+
+// the first fragment at or after `index` which the receiver does not have; count if there is none
+static uint8_t _rf_xfer_missing(uint8_t index) {
+	while ((index < _rf_xfer.count) && _rf_xfer_has(index))
+		index++;
+	return index;
+}
+
+// a frame for the receiver
+static void _rf_xfer_receive_frame(RFFRAME *frame) {
+	uint8_t *p = frame->data;
+
+	if ((frame->length >= 4) && (p[0] == _RF_XFER_POLL)) {
+		uint16_t tag = p[2] | (p[3] << 8);
+		if (_rf_xfer.count && (p[1] == _rf_xfer.id) && (!tag || (tag == _rf_xfer.tag))) {
+			_rf_xfer.poll_time = clockMillis();
+			_rf_xfer_send_status();
+		}
+		return;
+	}
+	if ((frame->length < _RF_XFER_HEADER) || ((p[0] != _RF_XFER_DATA) && (p[0] != _RF_XFER_DATA_POLL)))
+		return;
+
+	// the first fragment of any transfer starts the reassembly
+	if (!_rf_xfer.count) {
+		uint16_t length = p[5] | (p[6] << 8);
+		if ((p[3] == 0) || (p[3] > RF_TRANSFER_FRAGMENTS) || (length > _rf_xfer.length)) {
+			_rf_xfer_finish(RF_TRANSFER_FAILED);	// the message does not fit
+			return;
+		}
+		_rf_xfer.id = p[1];
+		_rf_xfer.count = p[3];
+		_rf_xfer.fragment = p[4];
+		_rf_xfer.length = length;
+		_rf_xfer.peer = frame->src;
+		_rf_xfer.tag = (uint16_t)clockMicros() | 1;	// two receivers are unlikely to start in the same microsecond
+		_rf_xfer.start = clockMillis();
+	}
+	if ((p[1] != _rf_xfer.id) || (frame->src != _rf_xfer.peer) || (p[2] >= _rf_xfer.count))
+		return;
+	_rf_xfer.poll_time = clockMillis();
+
+	uint16_t offset = (uint16_t)p[2] * _rf_xfer.fragment;
+	uint8_t size = frame->length - _RF_XFER_HEADER;
+	if ((offset + size) <= _rf_xfer.length) {
+		memcpy(&_rf_xfer.data[offset], &p[_RF_XFER_HEADER], size);
+		_rf_xfer.map[p[2] >> 3] |= (1 << (p[2] & 7));
+	}
+
+	bool complete = (_rf_xfer_missing(0) >= _rf_xfer.count);
+	if ((p[0] == _RF_XFER_DATA_POLL) || complete)
+		_rf_xfer_send_status();
+	if (complete && (_rf_xfer.state == RF_TRANSFER_BUSY))
+		_rf_xfer_finish(RF_TRANSFER_DONE);
+}
+
+// a frame for the sender
+static void _rf_xfer_sender_frame(RFFRAME *frame) {
+	uint8_t *p = frame->data;
+
+	if ((frame->length < (4 + _RF_XFER_MAP_SIZE)) || (p[0] != _RF_XFER_STATUS) || (p[1] != _rf_xfer.id))
+		return;
+	if ((_rf_xfer.peer != RF_BROADCAST) && (frame->src != _rf_xfer.peer))
+		return;
+
+	// follow the first receiver which answers; a bitmap from another receiver would skip fragments this one lacks
+	uint16_t tag = p[2] | (p[3] << 8);
+	if (!_rf_xfer.tag)
+		_rf_xfer.tag = tag;
+	else if (tag != _rf_xfer.tag)
+		return;
+
+	// the receiver only ever gains fragments
+	for (uint8_t i = 0; i < _RF_XFER_MAP_SIZE; i++)
+		_rf_xfer.map[i] |= p[4 + i];
+	_rf_xfer.in_flight = 0;
+	_rf_xfer.retries = 0;
+	_rf_xfer.next = _rf_xfer_missing(0);
+	if (_rf_xfer.next >= _rf_xfer.count)
+		_rf_xfer_finish(RF_TRANSFER_DONE);
+}
+
+static void _rf_xfer_sender_run() {
+	// a window has been sent; wait for the status
+	if ((_rf_xfer.in_flight >= _rf_xfer_window) || (_rf_xfer.next >= _rf_xfer.count)) {
+		if ((clockMillis() - _rf_xfer.poll_time) < RF_TRANSFER_TIMEOUT)
+			return;
+		if (++_rf_xfer.retries > RF_TRANSFER_RETRIES) {
+			_rf_xfer_finish(RF_TRANSFER_FAILED);
+			return;
+		}
+		if (!_rf_xfer.tag) {
+			_rf_xfer_send_fragment(0, true);	// no receiver has answered; it may not have the first fragment to answer a poll
+		} else {
+			uint8_t frame[4] = {_RF_XFER_POLL, _rf_xfer.id, (uint8_t)_rf_xfer.tag, (uint8_t)(_rf_xfer.tag >> 8)};
+			_rf_xfer_send_frame(frame, sizeof(frame));
+		}
+		_rf_xfer.poll_time = clockMillis();
+		return;
+	}
+
+	// send the missing fragments of the next window as the TX queue has room
+	while ((_rf_xfer.in_flight < _rf_xfer_window) && (_rf_xfer.next < _rf_xfer.count) && (rfSendQueued() < RF_TX_QUEUE_SIZE)) {
+		uint8_t index = _rf_xfer.next;
+		uint8_t after = _rf_xfer_missing(index + 1);
+		bool poll = ((_rf_xfer.in_flight + 1) >= _rf_xfer_window) || (after >= _rf_xfer.count);
+
+		_rf_xfer_send_fragment(index, poll);
+		_rf_xfer.in_flight++;
+		_rf_xfer.next = after;
+		if (poll) {
+			_rf_xfer.in_flight = _rf_xfer_window;
+			_rf_xfer.poll_time = clockMillis();
+		}
+	}
+}
+
+
+/* ---
+#### void rfTransferWindow(uint8_t window)
+
+Set the number of fragments the sender sends before it waits for the status _(1 .. `RF_TRANSFER_FRAGMENTS`)_.
+The default is `RF_TRANSFER_WINDOW` _(4)_.
+--- */
+void rfTransferWindow(uint8_t window) {
+	if (window < 1)
+		window = 1;
+	if (window > RF_TRANSFER_FRAGMENTS)
+		window = RF_TRANSFER_FRAGMENTS;
+	_rf_xfer_window = window;
+}
+
+/* ---
+#### bool rfTransferSend(uint16_t address, const uint8_t *data, uint16_t length)
+
+Start sending `length` bytes of `data` to the SRXE with the short `address`, or to `RF_BROADCAST`.
+The data is not copied and must remain valid until the transfer is finished.
+Use `rfTransferPoll()` to do the work of the transfer.
+
+Returns `false` if the message needs more than `RF_TRANSFER_FRAGMENTS` fragments or the RF transceiver is not inited.
+--- */
+bool rfTransferSend(uint16_t address, const uint8_t *data, uint16_t length) {
+	if (!rfInited() || !length)
+		return false;
+	if ((address != RF_BROADCAST) && !_rf_ext)
+		return false;
+
+	uint8_t fragment = _rf_payload_max() - _RF_XFER_HEADER;
+	uint16_t count = (length + fragment - 1) / fragment;
+	if (count > RF_TRANSFER_FRAGMENTS)
+		return false;
+
+	memset(&_rf_xfer, 0, sizeof(_rf_xfer));
+	_rf_xfer.role = _RF_XFER_SEND;
+	_rf_xfer.state = RF_TRANSFER_BUSY;
+	_rf_xfer.id = ++_rf_xfer_id;
+	_rf_xfer.data = (uint8_t *)data;
+	_rf_xfer.length = length;
+	_rf_xfer.peer = address;
+	_rf_xfer.count = count;
+	_rf_xfer.fragment = fragment;
+	_rf_xfer.start = clockMillis();
+	return true;
+}
+
+/* ---
+#### void rfTransferReceive(uint8_t *buffer, uint16_t size)
+
+Start waiting for a message of up to `size` bytes. The first fragment of any transfer starts the reassembly;
+fragments of other transfers are then ignored. The transfer fails if the sender is silent for `RF_TRANSFER_INACTIVE` ms.
+Use `rfTransferPoll()` to do the work of the transfer.
+--- */
+void rfTransferReceive(uint8_t *buffer, uint16_t size) {
+	memset(&_rf_xfer, 0, sizeof(_rf_xfer));
+	_rf_xfer.role = _RF_XFER_RECEIVE;
+	_rf_xfer.state = RF_TRANSFER_BUSY;
+	_rf_xfer.data = buffer;
+	_rf_xfer.length = size;
+	_rf_xfer.peer = RF_BROADCAST;
+}
+
+/* ---
+#### uint8_t rfTransferPoll()
+
+Process the received frames and send the next fragments. Call this often while a transfer is busy.
+
+Returns `RF_TRANSFER_BUSY`, `RF_TRANSFER_DONE`, `RF_TRANSFER_FAILED`, or `RF_TRANSFER_IDLE` if no transfer has been started.
+
+**Note:** a receiver which is done continues to answer the status requests of the sender until another transfer is started.
+--- */
+uint8_t rfTransferPoll() {
+	RFFRAME *frame;
+
+	if (!_rf_xfer.role)
+		return RF_TRANSFER_IDLE;
+
+	while ((frame = rfRecvFrame())) {
+		if (_rf_xfer.role == _RF_XFER_RECEIVE)
+			_rf_xfer_receive_frame(frame);
+		else if (_rf_xfer.state == RF_TRANSFER_BUSY)
+			_rf_xfer_sender_frame(frame);
+		rfReleaseFrame();
+	}
+
+	if ((_rf_xfer.role == _RF_XFER_SEND) && (_rf_xfer.state == RF_TRANSFER_BUSY))
+		_rf_xfer_sender_run();
+	// the sender has gone away part way through the message
+	if ((_rf_xfer.role == _RF_XFER_RECEIVE) && (_rf_xfer.state == RF_TRANSFER_BUSY) && _rf_xfer.count &&
+		((clockMillis() - _rf_xfer.poll_time) >= RF_TRANSFER_INACTIVE))
+		_rf_xfer_finish(RF_TRANSFER_FAILED);
+	return _rf_xfer.state;
+}
+
+/* ---
+#### uint16_t rfTransferLength()
+
+Return the length of the message being received _(valid once the first fragment has arrived)_ or being sent.
+--- */
+uint16_t rfTransferLength() {
+	return _rf_xfer.length;
+}
+
+/* ---
+#### uint16_t rfTransferRate()
+
+Returns the goodput of the last transfer which finished, in bytes per second of message data.
+Fragments which were sent again and the status frames are not counted.
+
+Returns 0 if the clock is not running _(see `clockInit()`)_.
+--- */
+uint16_t rfTransferRate() {
+	if (!_rf_xfer_ms)
+		return 0;
+	return (uint16_t)(((uint32_t)_rf_xfer_bytes * 1000UL) / _rf_xfer_ms);
+}
+
+#endif // RF_TRANSFER
+#endif // __SRXE_RFTRANSFER_
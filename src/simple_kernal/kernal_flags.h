@@ -5,3 +5,4 @@
 #define KERNAL_EVENT_SLEEP     0x03  // The device is about to go to sleep
 #define KERNAL_EVENT_TIMER     0x04  // The timer intervl has elapsed
 #define KERNAL_EVENT_BATTERY   0x05  // The battery voltage has changed
+#define KERNAL_EVENT_PAINT     0x06  // Part of the screen is invalid; event_data is the number of rects (see KernalPaintRects)
@@ -38,6 +38,42 @@ static unsigned long _timer_interval = 0;
 static unsigned long _battery_check_timer;
 uint16_t _last_battery_level = 0;
 
+// An area of the screen; x and cx are in triplets, y and cy are in pixels (the same as the LCD functions)
+typedef struct
+{
+    int x, y;
+    int cx, cy;
+} KRECT;
+
+#define KERNAL_MAX_INVALID_RECTS 4
+
+// the damage collected since the last paint and the damage being painted
+static KRECT _kernal_invalid[KERNAL_MAX_INVALID_RECTS];
+static uint8_t _kernal_invalid_count;
+static KRECT _kernal_paint[KERNAL_MAX_INVALID_RECTS];
+static uint8_t _kernal_paint_count;
+
+// grow a to cover b
+void _kernal_rect_union(KRECT *a, const KRECT *b)
+{
+    int x1 = ((a->x + a->cx) > (b->x + b->cx)) ? (a->x + a->cx) : (b->x + b->cx);
+    int y1 = ((a->y + a->cy) > (b->y + b->cy)) ? (a->y + a->cy) : (b->y + b->cy);
+    if (b->x < a->x)
+        a->x = b->x;
+    if (b->y < a->y)
+        a->y = b->y;
+    a->cx = x1 - a->x;
+    a->cy = y1 - a->y;
+}
+
+// true if the areas overlap, or touch when adjacent is set
+bool _kernal_rect_touches(const KRECT *a, const KRECT *b, bool adjacent)
+{
+    int gap = adjacent ? 1 : 0;
+    return (a->x < (b->x + b->cx + gap)) && (b->x < (a->x + a->cx + gap)) &&
+           (a->y < (b->y + b->cy + gap)) && (b->y < (a->y + a->cy + gap));
+}
+
 //******************************** Kernal Exposed API Functions ********************************
 
 // This should be used for things that dont require alot of accuracy, its a lazy way to keep pumping the app events
@@ -59,8 +95,119 @@ bool KernalRegisterEventHandler(KERNAL_EVENT_HANDLER event_handler)
     return false;
 }
 
+/// @brief Marks an area of the screen as needing to be repainted
+/// @details The areas are coalesced and a single KERNAL_EVENT_PAINT is sent once the message queue is empty
+/// @param rect The area, NULL for the whole screen
+void InvalidateRect(const KRECT *rect)
+{
+    KRECT r = {0, 0, LCD_WIDTH, LCD_HEIGHT};
+
+    if (rect != NULL)
+    {
+        r = *rect;
+        // clip to the screen
+        if (r.x < 0)
+        {
+            r.cx += r.x;
+            r.x = 0;
+        }
+        if (r.y < 0)
+        {
+            r.cy += r.y;
+            r.y = 0;
+        }
+        if ((r.x + r.cx) > LCD_WIDTH)
+            r.cx = LCD_WIDTH - r.x;
+        if ((r.y + r.cy) > LCD_HEIGHT)
+            r.cy = LCD_HEIGHT - r.y;
+        if ((r.cx <= 0) || (r.cy <= 0))
+            return;
+    }
+
+    // merge with any area it overlaps or touches; the merged area may now touch another one
+    uint8_t i = 0;
+    while (i < _kernal_invalid_count)
+    {
+        if (_kernal_rect_touches(&_kernal_invalid[i], &r, true))
+        {
+            _kernal_rect_union(&r, &_kernal_invalid[i]);
+            _kernal_invalid[i] = _kernal_invalid[--_kernal_invalid_count];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+
+    if (_kernal_invalid_count < KERNAL_MAX_INVALID_RECTS)
+    {
+        _kernal_invalid[_kernal_invalid_count++] = r;
+        return;
+    }
+
+    // the list is full; grow the area which grows the least
+    uint8_t best = 0;
+    long best_growth = 0;
+    for (i = 0; i < _kernal_invalid_count; i++)
+    {
+        KRECT u = _kernal_invalid[i];
+        _kernal_rect_union(&u, &r);
+        long growth = ((long)u.cx * u.cy) - ((long)_kernal_invalid[i].cx * _kernal_invalid[i].cy);
+        if ((i == 0) || (growth < best_growth))
+        {
+            best = i;
+            best_growth = growth;
+        }
+    }
+    _kernal_rect_union(&_kernal_invalid[best], &r);
+}
+
+/// @brief Gets the areas being repainted during a KERNAL_EVENT_PAINT
+/// @param rects Set to the list of areas
+/// @return The number of areas
+uint8_t KernalPaintRects(const KRECT **rects)
+{
+    *rects = _kernal_paint;
+    return _kernal_paint_count;
+}
+
+/// @brief Gets a single area which covers all of the areas being repainted during a KERNAL_EVENT_PAINT
+void KernalPaintBounds(KRECT *bounds)
+{
+    *bounds = (KRECT){0, 0, 0, 0};
+    for (uint8_t i = 0; i < _kernal_paint_count; i++)
+    {
+        if (i == 0)
+            *bounds = _kernal_paint[0];
+        else
+            _kernal_rect_union(bounds, &_kernal_paint[i]);
+    }
+}
+
+/// @brief Checks if an area of the screen must be drawn during a KERNAL_EVENT_PAINT
+/// @return true if the area overlaps any of the areas being repainted
+bool KernalPaintNeeded(int x, int y, int cx, int cy)
+{
+    KRECT r = {x, y, cx, cy};
+    for (uint8_t i = 0; i < _kernal_paint_count; i++)
+    {
+        if (_kernal_rect_touches(&_kernal_paint[i], &r, false))
+            return true;
+    }
+    return false;
+}
+
 //******************************** Internal Functions ********************************
 
+// move the collected damage to the paint list; anything invalidated while painting is collected for the next paint
+void _kernal_begin_paint(KMSG *msg)
+{
+    memcpy(_kernal_paint, _kernal_invalid, sizeof(KRECT) * _kernal_invalid_count);
+    _kernal_paint_count = _kernal_invalid_count;
+    _kernal_invalid_count = 0;
+
+    *msg = (KMSG){.event_id = KERNAL_EVENT_PAINT, .event_data = _kernal_paint_count};
+}
+
 void _kernal_init(void)
 {
     _kernal_message_queue = createQueue_KMSG(KERNAL_MAX_EVENT_QUEUE_SIZE);
@@ -72,6 +219,7 @@ void _kernal_init(void)
     _keyscan_timer = clockMillis();
 
     Enqueue_KMSG(_kernal_message_queue, (KMSG){.event_id = KERNAL_EVENT_WAKEUP});
+    InvalidateRect(NULL);
 }
 
 void _do_appsafe_sleep()
@@ -90,6 +238,7 @@ void _do_appsafe_sleep()
     _last_key_pressed_time = _keyscan_timer = clockMillis();
 
     Enqueue_KMSG(_kernal_message_queue, (KMSG){.event_id = KERNAL_EVENT_WAKEUP});
+    InvalidateRect(NULL);
 }
 
 int _handle_keypress_checks(void)
@@ -199,6 +348,7 @@ void _kernal_check_for_changes(void)
 
 
 /// @brief Gets the next message from the kernal, if there is no message avalable, this call will block until there is one
+/// @details A KERNAL_EVENT_PAINT is only returned when no other message is waiting, so the damage from several events is painted once
 /// @param msg The message to fill
 /// @return Continue pumping messages + error codes
 bool KernalGetMessage(KMSG *msg)
@@ -207,6 +357,12 @@ bool KernalGetMessage(KMSG *msg)
     while (QueueEmpty_KMSG(_kernal_message_queue))
     {
         _kernal_check_for_changes();
+
+        if (QueueEmpty_KMSG(_kernal_message_queue) && _kernal_invalid_count)
+        {
+            _kernal_begin_paint(msg);
+            return true;
+        }
     }
 
     *msg = front_KMSG(_kernal_message_queue);
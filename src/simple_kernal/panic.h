@@ -11,6 +11,12 @@ void _reboot(void)
 
 void _panic(const char *sender, const char *msg, int error_code, bool halt)
 {
+#ifdef SRXE_PROFILE
+    // take the counters before the panic screen adds its own drawing
+    SRXEPROFILE profile;
+    srxeProfileSnapshot(&profile);
+#endif
+
     // Clear the screen
     lcdClearScreen();
 
@@ -26,6 +32,14 @@ void _panic(const char *sender, const char *msg, int error_code, bool halt)
     lcdPutStringAt("Error Code:", 0, lcdFontHeightGet() * 2);
     lcdPutStringAt(error_code_str, 0, lcdFontHeightGet() * 3);
 
+#ifdef SRXE_PROFILE
+    // the LCD and SPI counters go below the prompts
+    lcdPositionSet(0, lcdFontHeightGet() * 7);
+    lcdFontSet(FONT1);
+    printProfile(PRINT_LCD, &profile);
+    lcdFontSet(FONT2);
+#endif
+
     if (halt)
     {
 
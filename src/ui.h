@@ -57,6 +57,17 @@ enum {
 #define _MENU_PADDING 			1
 #define _MENU_TIGHT					// pull menu text to edge of screen
 
+#ifdef LCD_BAND
+// the menu shapes overlap; each menu item is recorded and rendered so its pixels are sent once
+#define _MENU_BITMAP	lcdBandBitmap
+#define _MENU_RECTANGLE	lcdBandRectangle
+#define _MENU_TEXT		lcdBandText
+#else
+#define _MENU_BITMAP	lcdBitmap
+#define _MENU_RECTANGLE	lcdRectangle
+#define _MENU_TEXT		lcdPutStringAt
+#endif
+
 /* ---
 #### void uiMenu()
 
@@ -160,6 +171,9 @@ uint8_t uiMenu(const char* menus[], const char* title, uint8_t menu_shape, bool
 			// draw menu item background
 			if ((y + mheight) > LCD_HEIGHT)
 				y = LCD_HEIGHT - mheight;
+#ifdef LCD_BAND
+			lcdBandBegin(LCD_WHITE);
+#endif
 
 			switch (menu_shape) {
 				case UI_MENU_CLEAR: {
@@ -167,7 +181,7 @@ uint8_t uiMenu(const char* menus[], const char* title, uint8_t menu_shape, bool
 				} break;
 				case UI_MENU_RECTANGLE: {
 					lcdColorSet(LCD_WHITE, LCD_BLACK);	// text color will need to be inverted
-					lcdRectangle(x, y, mwidth, mheight, LCD_ERASE);
+					_MENU_RECTANGLE(x, y, mwidth, mheight, LCD_ERASE);
 				} break;
 				case UI_MENU_ROUND_END: {
 					lcdColorSet(LCD_WHITE, LCD_BLACK);	// text color will need to be inverted
@@ -175,19 +189,19 @@ uint8_t uiMenu(const char* menus[], const char* title, uint8_t menu_shape, bool
 					if (i < 5) {
 						// rounded end is on the right for left side menus
 						// we draw the bitmap first because it may include pixels of various shades; the subsequent rectangle will cover those up
-						lcdBitmap(x + (mwidth - TRIPLET_FROM_ACTUAL(MENU_BALL18_WIDTH)), y, menu_ball18, false);
-						lcdRectangle(x, y, mwidth - xd, mheight, LCD_ERASE);
+						_MENU_BITMAP(x + (mwidth - TRIPLET_FROM_ACTUAL(MENU_BALL18_WIDTH)), y, menu_ball18, false);
+						_MENU_RECTANGLE(x, y, mwidth - xd, mheight, LCD_ERASE);
 					} else {
-						lcdBitmap(x, y, menu_ball18, false);
-						lcdRectangle(x + xd, y, mwidth - xd, mheight, LCD_ERASE);
+						_MENU_BITMAP(x, y, menu_ball18, false);
+						_MENU_RECTANGLE(x + xd, y, mwidth - xd, mheight, LCD_ERASE);
 					}
 				} break;
 				case UI_MENU_ROUNDED: {
 					lcdColorSet(LCD_WHITE, LCD_BLACK);	// text color will need to be inverted
 					// we draw the bitmap first because it may include pixels of various shades; the subsequent rectangle will cover those up
-					lcdBitmap(x, y, menu_ball18, false);
-					lcdBitmap(x + (mwidth - TRIPLET_FROM_ACTUAL(MENU_BALL18_WIDTH)), y, menu_ball18, false);
-					lcdRectangle(x + xd, y, mwidth - (xd * 2), mheight, LCD_ERASE);
+					_MENU_BITMAP(x, y, menu_ball18, false);
+					_MENU_BITMAP(x + (mwidth - TRIPLET_FROM_ACTUAL(MENU_BALL18_WIDTH)), y, menu_ball18, false);
+					_MENU_RECTANGLE(x + xd, y, mwidth - (xd * 2), mheight, LCD_ERASE);
 				} break;
 			}
 #ifdef _MENU_TIGHT
@@ -197,7 +211,10 @@ uint8_t uiMenu(const char* menus[], const char* title, uint8_t menu_shape, bool
 			}
 #endif
 			// render menu text
-			lcdPutStringAt(menus[i], x + xd, (y + (_MENU_PADDING * TRIPLET_SIZE)) -1);
+			_MENU_TEXT(menus[i], x + xd, (y + (_MENU_PADDING * TRIPLET_SIZE)) -1);
+#ifdef LCD_BAND
+			lcdBandRender();
+#endif
 		}
 		y += _MENU_POSITION_DELTA;
 	}